@@ -0,0 +1,60 @@
+/*
+ * Copyright (c) 2025 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+#include <zephyr/kernel.h>
+
+#include <pb_encode.h>
+
+/*
+ * Per command latency histograms of the Bridge core, see core.LatencyStats. The functions are only
+ * built with CONFIG_ZMK_BRIDGE_LATENCY_STATS, without it BRIDGE_LATENCY_STAMP compiles to nothing.
+ */
+
+#define BRIDGE_LATENCY_BUCKETS 20
+
+enum bridge_latency_stage {
+    BRIDGE_LATENCY_STAGE_DECODE,
+    BRIDGE_LATENCY_STAGE_HANDLE,
+    BRIDGE_LATENCY_STAGE_RESPOND,
+    BRIDGE_LATENCY_STAGE_COUNT,
+};
+
+// Cycle counts taken at the start and the end of every stage of one request.
+struct bridge_latency_stamps {
+    uint32_t received;
+    uint32_t decoded;
+    uint32_t handled;
+    uint32_t responded;
+};
+
+#if IS_ENABLED(CONFIG_ZMK_BRIDGE_LATENCY_STATS)
+#define BRIDGE_LATENCY_STAMP(_stamp) ((_stamp) = k_cycle_get_32())
+#else
+#define BRIDGE_LATENCY_STAMP(_stamp) ((void)0)
+#endif // IS_ENABLED(CONFIG_ZMK_BRIDGE_LATENCY_STATS)
+
+/**
+ * @brief Add the stages of one request to the histograms of its command.
+ * @param subsystem Field number of the subsystem in bridge.Request, 0 for Bridge requests.
+ * @param request Field number of the request in the subsystem's Request, or in bridge.Request.
+ */
+void bridge_latency_record(uint8_t subsystem, uint8_t request,
+                           const struct bridge_latency_stamps *stamps);
+
+void bridge_latency_reset(void);
+
+/**
+ * @brief Copy the histograms for bridge_latency_encode_commands(). The copy is shared, so take and
+ * encode it from one thread only.
+ * @retval The number of requests that were not recorded, see core.LatencyStats.dropped.
+ */
+uint32_t bridge_latency_snapshot(void);
+
+// Encodes the last snapshot as core.LatencyStats.commands.
+bool bridge_latency_encode_commands(pb_ostream_t *stream, const pb_field_t *field,
+                                    void *const *arg);
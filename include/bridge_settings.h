@@ -0,0 +1,57 @@
+/*
+ * Copyright (c) 2025 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/iterable_sections.h>
+
+/*
+ * Values that subsystems keep across reboots, stored under "bridge/<key>". Changes only update a
+ * copy in RAM and are written to flash together once no setting changed for
+ * CONFIG_ZMK_BRIDGE_SETTINGS_SAVE_DEBOUNCE, so a stream of slider updates costs one write and none
+ * of it happens on the request path.
+ */
+struct bridge_setting {
+    const char *key;
+    // The newest value, guarded by the settings lock.
+    void *value;
+    const void *default_value;
+    size_t size;
+    // Applies a value that was loaded from flash. Optional.
+    void (*load)(const void *value);
+    // The value differs from the one in flash.
+    bool *dirty;
+};
+
+/**
+ * @brief Define a setting of type @p _type, the default value follows as the last argument.
+ */
+#define BRIDGE_SETTING_DEFINE(_name, _key, _type, _load, ...)                                      \
+    BUILD_ASSERT(sizeof(_type) <= CONFIG_ZMK_BRIDGE_SETTINGS_MAX_VALUE_SIZE,                       \
+                 "Setting " _key " is larger than CONFIG_ZMK_BRIDGE_SETTINGS_MAX_VALUE_SIZE");     \
+    static const _type _name##_default = __VA_ARGS__;                                              \
+    static _type _name##_value = __VA_ARGS__;                                                      \
+    static bool _name##_dirty;                                                                     \
+    STRUCT_SECTION_ITERABLE(bridge_setting, _name) = {                                             \
+        .key = _key,                                                                               \
+        .value = &_name##_value,                                                                   \
+        .default_value = &_name##_default,                                                         \
+        .size = sizeof(_type),                                                                     \
+        .load = _load,                                                                             \
+        .dirty = &_name##_dirty,                                                                   \
+    };
+
+/**
+ * @brief Store a new value and schedule a write. Values equal to the current one are ignored.
+ */
+void bridge_settings_set(const struct bridge_setting *setting, const void *value);
+
+/**
+ * @brief Put every setting back to its default and delete the stored values with the next write.
+ * What is currently applied is left alone, the defaults take effect on the next boot.
+ */
+void bridge_settings_reset(void);
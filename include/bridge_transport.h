@@ -0,0 +1,169 @@
+/*
+ * Copyright (c) 2025 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/iterable_sections.h>
+#include <zephyr/sys/ring_buffer.h>
+
+#include <bridge.pb.h>
+#include <uart_framing.h>
+
+/*
+ * A link to one host. Every session has its own buffers and framing state, while the handlers and
+ * the worker threads that run them are shared. Transport backends define sessions with
+ * BRIDGE_SESSION_DEFINE, hand received data to bridge_transport_rx() and pick up encoded frames
+ * with bridge_transport_tx_claim() and bridge_transport_tx_finish().
+ */
+struct bridge_session;
+
+struct bridge_transport_api {
+    // Called once the session is set up, starts receiving.
+    int (*init)(const struct bridge_session *session);
+    // Bytes are waiting to be sent, either a complete frame or at least mtu bytes of one.
+    void (*tx_submit)(const struct bridge_session *session, bool frame_done);
+    // The TX queue is full, return once the transport has taken some of it.
+    void (*tx_wait)(const struct bridge_session *session);
+    // A frame buffer was released after bridge_transport_rx_ready() returned false. Optional.
+    void (*rx_resume)(const struct bridge_session *session);
+    // The thread that receives for the session, if it has one, for its stack usage. Optional.
+    struct k_thread *(*rx_thread)(const struct bridge_session *session);
+};
+
+// Aligned so an array of them can back a k_mem_slab.
+struct bridge_rx_frame {
+    uint16_t len;
+    // One spare byte tells a frame that fills the buffer from one that overflows it.
+    uint8_t data[CONFIG_ZMK_BRIDGE_RX_FRAME_SIZE + 1];
+#if IS_ENABLED(CONFIG_ZMK_BRIDGE_LATENCY_STATS)
+    // Cycle count when the first byte of the frame was received.
+    uint32_t received_cycles;
+#endif // IS_ENABLED(CONFIG_ZMK_BRIDGE_LATENCY_STATS)
+} __aligned(sizeof(void *));
+
+struct bridge_notification_frame {
+    uint16_t len;
+    uint8_t data[CONFIG_ZMK_BRIDGE_NOTIFICATION_MAX_SIZE];
+};
+
+// Peaks and counters reported in bridge.Telemetry.
+struct bridge_session_telemetry {
+    atomic_t tx_buf_peak;
+    atomic_t rx_frames_peak;
+    atomic_t notification_high_peak;
+    atomic_t notification_low_peak;
+    atomic_t encode_failures;
+    atomic_t notifications_dropped;
+};
+
+struct bridge_session_state {
+    // Reserved for the queue of sessions waiting for a worker.
+    void *fifo_reserved;
+    const struct bridge_session *session;
+    // Set while the session is queued for or served by a worker.
+    atomic_t scheduled;
+
+    struct k_mem_slab rx_frame_slab;
+    // Complete frames waiting for a worker, so the host can pipeline requests.
+    struct k_msgq rx_frame_queue;
+
+    // RX path state, touched by the transport and by the RX timeout.
+    struct k_spinlock rx_lock;
+    struct uart_framing_decoder rx_decoder;
+    struct bridge_rx_frame *rx_frame;
+    // Why the frame being received is dropped, NAK_REASON_UNSPECIFIED while it is not.
+    bridge_NakReason rx_drop_reason;
+    struct k_timer rx_timer;
+
+    struct ring_buf tx_buf;
+    struct k_mutex tx_mutex;
+    // Written under tx_mutex by the worker serving the session, see switch_framing().
+    enum uart_framing_codec tx_codec;
+    // The frame being sent, under tx_mutex. Kept here as the COBS block is too big for a stack.
+    struct uart_framing_encoder tx_encoder;
+    uint32_t tx_check;
+
+    struct k_msgq notification_high_queue;
+    struct k_msgq notification_low_queue;
+
+    atomic_t rx_frames;
+    atomic_t link_errors[_bridge_NakReason_ARRAYSIZE];
+    // NAKs that still have to be sent, one bit per bridge_NakReason.
+    atomic_t pending_naks;
+#if IS_ENABLED(CONFIG_ZMK_BRIDGE_TELEMETRY)
+    struct bridge_session_telemetry telemetry;
+#endif // IS_ENABLED(CONFIG_ZMK_BRIDGE_TELEMETRY)
+};
+
+struct bridge_session_buffers {
+    uint8_t *rx_frames;
+    uint8_t *rx_frame_queue;
+    uint8_t *tx;
+    uint8_t *notification_high_queue;
+    uint8_t *notification_low_queue;
+};
+
+struct bridge_session {
+    const char *name;
+    const struct bridge_transport_api *api;
+    // Backend specific, for example the UART device.
+    const void *config;
+    void *data;
+    // How much of a frame is worth handing over before the frame is complete.
+    size_t mtu;
+    struct bridge_session_state *state;
+    struct bridge_session_buffers buffers;
+};
+
+#define BRIDGE_SESSION_DEFINE(_name, _api, _config, _data, _mtu)                                   \
+    static struct bridge_rx_frame _name##_rx_frames[CONFIG_ZMK_BRIDGE_RX_FRAME_COUNT];             \
+    static struct bridge_rx_frame *_name##_rx_frame_queue[CONFIG_ZMK_BRIDGE_RX_FRAME_COUNT];       \
+    static uint8_t _name##_tx_buf[CONFIG_ZMK_BRIDGE_TX_BUF_SIZE];                                  \
+    static struct bridge_notification_frame                                                        \
+        _name##_notification_high[CONFIG_ZMK_BRIDGE_NOTIFICATION_HIGH_QUEUE_SIZE];                 \
+    static struct bridge_notification_frame                                                        \
+        _name##_notification_low[CONFIG_ZMK_BRIDGE_NOTIFICATION_LOW_QUEUE_SIZE];                   \
+    static struct bridge_session_state _name##_session_state;                                      \
+    STRUCT_SECTION_ITERABLE(bridge_session, _name) = {                                             \
+        .name = #_name,                                                                            \
+        .api = _api,                                                                               \
+        .config = _config,                                                                         \
+        .data = _data,                                                                             \
+        .mtu = _mtu,                                                                               \
+        .state = &_name##_session_state,                                                           \
+        .buffers =                                                                                 \
+            {                                                                                      \
+                .rx_frames = (uint8_t *)_name##_rx_frames,                                         \
+                .rx_frame_queue = (uint8_t *)_name##_rx_frame_queue,                               \
+                .tx = _name##_tx_buf,                                                              \
+                .notification_high_queue = (uint8_t *)_name##_notification_high,                   \
+                .notification_low_queue = (uint8_t *)_name##_notification_low,                     \
+            },                                                                                     \
+    };
+
+/**
+ * @brief Make sure a frame buffer is ready for received data. Transports that can hold data back
+ * should check this first and wait for rx_resume when it fails, otherwise frames get dropped.
+ */
+bool bridge_transport_rx_ready(const struct bridge_session *session);
+
+/**
+ * @brief Hand received bytes to the Bridge core. Must not be called concurrently for one session.
+ */
+void bridge_transport_rx(const struct bridge_session *session, const uint8_t *data, size_t len);
+
+/**
+ * @brief Claim up to @p size queued bytes to send, see ring_buf_get_claim().
+ * @retval The number of bytes claimed, 0 if nothing is queued.
+ */
+uint32_t bridge_transport_tx_claim(const struct bridge_session *session, uint8_t **data,
+                                   uint32_t size);
+
+/**
+ * @brief Release @p len bytes of the last claim once they have been sent.
+ */
+void bridge_transport_tx_finish(const struct bridge_session *session, uint32_t len);
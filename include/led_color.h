@@ -0,0 +1,55 @@
+/*
+ * Copyright (c) 2025 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+#include <zephyr/drivers/led_strip.h>
+
+#include <zmk/rgb_underglow.h>
+
+/*
+ * Integer only color conversions for LED strips, cheap on cores without an FPU. HSB colors use the
+ * ranges of struct zmk_led_hsb: hue 0 to 359 degrees, saturation and brightness 0 to 100 percent.
+ * Every result is rounded to the nearest representable value.
+ */
+
+#define LED_COLOR_HUE_MAX 360
+#define LED_COLOR_SAT_MAX 100
+#define LED_COLOR_BRT_MAX 100
+
+struct zmk_led_hsb led_color_rgb_to_hsb(struct led_rgb rgb);
+
+struct led_rgb led_color_hsb_to_rgb(struct zmk_led_hsb hsb);
+
+void led_color_rgb_to_hsb_buf(const struct led_rgb *rgb, struct zmk_led_hsb *hsb, size_t count);
+
+void led_color_hsb_to_rgb_buf(const struct zmk_led_hsb *hsb, struct led_rgb *rgb, size_t count);
+
+/**
+ * @brief Interpolate between two colors, @p t going from 0 at @p from to 65536 at @p to. Hue takes
+ * the shorter way around the circle.
+ */
+struct zmk_led_hsb led_color_hsb_lerp(struct zmk_led_hsb from, struct zmk_led_hsb to, uint32_t t);
+
+/**
+ * @brief Scale a channel by @p scale / 255.
+ */
+static inline uint8_t led_color_scale8(uint8_t value, uint8_t scale) {
+    // Exact round(value * scale / 255) for 16 bit products.
+    const uint32_t product = (uint32_t)value * scale + 128;
+    return (product + (product >> 8)) >> 8;
+}
+
+/**
+ * @brief Fill a per-channel lookup table that applies gamma 2.2 correction, if @p gamma is set,
+ * followed by scaling to @p brightness / 255.
+ */
+void led_color_lut_build(uint8_t lut[256], bool gamma, uint8_t brightness);
+
+/**
+ * @brief Map every channel of @p count pixels through @p lut in place.
+ */
+void led_color_lut_apply(const uint8_t lut[256], struct led_rgb *pixels, size_t count);
@@ -20,6 +20,47 @@ enum uart_framing_state {
 #define FRAMING_ESC 0xAC
 #define FRAMING_EOF 0xAD
 
+// Length of the check value that trails the data of every frame, 0 when frames carry none.
+#if IS_ENABLED(CONFIG_ZMK_BRIDGE_FRAME_CHECK_CRC32)
+#define UART_FRAMING_CHECK_LEN 4
+#elif IS_ENABLED(CONFIG_ZMK_BRIDGE_FRAME_CHECK_CRC16)
+#define UART_FRAMING_CHECK_LEN 2
+#else
+#define UART_FRAMING_CHECK_LEN 0
+#endif
+
+enum uart_framing_codec {
+    // SOF, data with framing bytes escaped, EOF.
+    UART_FRAMING_CODEC_ESCAPE,
+    // Consistent Overhead Byte Stuffing, frames end with a zero byte.
+    UART_FRAMING_CODEC_COBS,
+};
+
+struct uart_framing_decoder {
+    enum uart_framing_codec codec;
+    enum uart_framing_state state;
+    // COBS: data bytes left in the current block, and whether the block ends in a zero.
+    uint8_t cobs_left;
+    bool cobs_zero;
+};
+
+struct uart_framing_encoder {
+    enum uart_framing_codec codec;
+    // The frame has not been started on the wire yet.
+    bool start_pending;
+    // An escape byte has been written, but the byte it escapes has not.
+    bool escape_pending;
+#if IS_ENABLED(CONFIG_ZMK_BRIDGE_FRAMING_COBS)
+    // The block being built, its code byte first, and how much of it has been written out once it
+    // is complete.
+    uint8_t cobs_block[255];
+    uint8_t cobs_len;
+    uint8_t cobs_written;
+    bool cobs_flushing;
+    bool cobs_final;
+#endif // IS_ENABLED(CONFIG_ZMK_BRIDGE_FRAMING_COBS)
+};
+
 /**
  * @brief Process an incoming byte from a frame. Will possibly update the framing state depending on
  * what data is received.
@@ -29,3 +70,71 @@ enum uart_framing_state {
  * has been updated.
  */
 bool uart_framing_process_byte(enum uart_framing_state *uart_fs, uint8_t c);
+
+/**
+ * @brief Reset @p dec to wait for the start of a frame encoded with @p codec.
+ */
+void uart_framing_decoder_init(struct uart_framing_decoder *dec, enum uart_framing_codec codec);
+
+/**
+ * @brief Carry on after FRAMING_STATE_ERR. With the escape codec the SOF that cut the frame short
+ * starts the next frame, with COBS the zero that did is the delimiter in front of it.
+ */
+void uart_framing_decoder_resync(struct uart_framing_decoder *dec);
+
+/**
+ * @brief Decode a block of incoming frame data. Framing bytes update the framing state, stuffed or
+ * escaped bytes are restored and runs of plain data are copied to @p out in bulk. Decoding stops
+ * right after the end of a frame (the state becomes FRAMING_STATE_EOF), right after a byte that
+ * aborts the current frame (the state becomes FRAMING_STATE_ERR), once @p out is full or once @p in
+ * is exhausted. FRAMING_STATE_AWAITING_DATA and FRAMING_STATE_ESCAPED mean a frame is underway.
+ * @param consumed Set to the number of bytes of @p in that have been processed.
+ * @retval The number of data bytes written to @p out.
+ */
+size_t uart_framing_decode(struct uart_framing_decoder *dec, const uint8_t *in, size_t in_len,
+                           size_t *consumed, uint8_t *out, size_t out_len);
+
+/**
+ * @brief Start a new outgoing frame encoded with @p codec.
+ */
+void uart_framing_encoder_init(struct uart_framing_encoder *enc, enum uart_framing_codec codec);
+
+/**
+ * @brief Encode a block of outgoing frame data into @p out. Runs of plain data are copied in bulk.
+ * If @p out fills up in the middle of an escape sequence or a COBS block, the encoder remembers it
+ * and carries on there on the next call.
+ * @param consumed Set to the number of bytes of @p in that the encoder is done with.
+ * @retval The number of bytes written to @p out.
+ */
+size_t uart_framing_encode(struct uart_framing_encoder *enc, const uint8_t *in, size_t in_len,
+                           size_t *consumed, uint8_t *out, size_t out_len);
+
+/**
+ * @brief Write whatever the encoder still holds and the end of the frame into @p out.
+ * @param done Set once the frame is complete, call again with more room otherwise.
+ * @retval The number of bytes written to @p out.
+ */
+size_t uart_framing_encode_end(struct uart_framing_encoder *enc, uint8_t *out, size_t out_len,
+                               bool *done);
+
+/**
+ * @brief Start the check value of a new frame.
+ */
+uint32_t uart_framing_check_init(void);
+
+/**
+ * @brief Run unescaped frame data through the check value: CRC-16/CCITT-FALSE or CRC-32/ISO-HDLC,
+ * depending on the configuration.
+ */
+uint32_t uart_framing_check_update(uint32_t check, const uint8_t *data, size_t len);
+
+/**
+ * @brief Store the UART_FRAMING_CHECK_LEN byte trailer for @p check, little endian, in @p out.
+ */
+void uart_framing_check_put(uint32_t check, uint8_t *out);
+
+/**
+ * @brief Verify the trailer of a received and decoded frame of @p len bytes.
+ * @retval true if the trailer matches the data in front of it.
+ */
+bool uart_framing_check_frame(const uint8_t *frame, size_t len);
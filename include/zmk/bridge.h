@@ -8,30 +8,44 @@
 #pragma once
 
 #include <bridge.pb.h>
+#include <pb_decode.h>
 #include <zephyr/sys/iterable_sections.h>
 #include <zephyr/sys/ring_buffer.h>
 #include <zmk/behavior.h>
 #include <zephyr/sys/util.h>
 
 typedef bridge_Response(bridge_func)(const bridge_Request *req);
-typedef uint8_t(bridge_request_id)(const bridge_Request *req);
+
+/*
+ * Completion token of an asynchronous request, owned by its handler until it is passed to
+ * bridge_complete().
+ */
+struct bridge_completion;
+
+typedef void(bridge_async_func)(const bridge_Request *req, struct bridge_completion *completion);
 
 #define STR(x) #x
 #define XSTR(x) STR(x)
 
 struct bridge_subsystem_handler {
     bridge_func *func;
-    // FIXME: create subsystems struct, autogen it, etc
-    bridge_request_id *bridge_request_id;
+    // Set instead of func by BRIDGE_SUBSYSTEM_HANDLER_ASYNC.
+    bridge_async_func *async_func;
     uint8_t subsystem_choice;
     uint8_t request_choice;
 };
 
-// TODO: add request_id to response.
+/*
+ * Row of the dispatch table generated by scripts/gen_dispatch_table.py, indexed by the request
+ * tag of a single subsystem.
+ */
+struct bridge_dispatch_row {
+    const struct bridge_subsystem_handler *const *handlers;
+    uint8_t len;
+    uint16_t which_request_type_offset;
+};
+
 #define BRIDGE_SUBSYSTEM_HANDLER(prefix, request_id)                                               \
-    uint8_t subsystem_func_##request_id(const bridge_Request *req) {                               \
-        return req->subsystem.prefix.which_request_type;                                           \
-    }                                                                                              \
     bridge_Response exec_func_##request_id(const bridge_Request *req) {                            \
         LOG_INF("Calling Bridge handler: %s", XSTR(request_id));                                   \
         bridge_Response response = request_id(req);                                                \
@@ -39,13 +53,85 @@ struct bridge_subsystem_handler {
     }                                                                                              \
     STRUCT_SECTION_ITERABLE(bridge_subsystem_handler, prefix##_subsystem_handler_##request_id) = { \
         .func = exec_func_##request_id,                                                            \
-        .bridge_request_id = subsystem_func_##request_id,                                          \
         .subsystem_choice = bridge_Request_##prefix##_tag,                                         \
         .request_choice = bridge_##prefix##_Request_##request_id##_tag,                            \
     };
 
+/*
+ * Like BRIDGE_SUBSYSTEM_HANDLER, for handlers that may take long, such as a flash erase. The
+ * handler runs on the Bridge work queue with a copy of the request and answers it whenever it is
+ * done through bridge_complete(), while later requests are handled in the meantime. Data that a
+ * subsystem decoder placed outside of the request is not copied. Asynchronous handlers run one at
+ * a time, but concurrently with the synchronous ones, and can not be batched.
+ */
+#define BRIDGE_SUBSYSTEM_HANDLER_ASYNC(prefix, request_id)                                         \
+    void exec_async_func_##request_id(const bridge_Request *req,                                   \
+                                      struct bridge_completion *completion) {                      \
+        LOG_INF("Calling async Bridge handler: %s", XSTR(request_id));                             \
+        request_id(req, completion);                                                               \
+    }                                                                                              \
+    STRUCT_SECTION_ITERABLE(bridge_subsystem_handler, prefix##_subsystem_handler_##request_id) = { \
+        .async_func = exec_async_func_##request_id,                                                \
+        .subsystem_choice = bridge_Request_##prefix##_tag,                                         \
+        .request_choice = bridge_##prefix##_Request_##request_id##_tag,                            \
+    };
+
+/**
+ * @brief Send the response to an asynchronous request, tagged with its request id, and release the
+ * completion token. Call exactly once per token, from any thread but an ISR. The response may
+ * overtake the responses to later requests.
+ */
+void bridge_complete(struct bridge_completion *completion, const bridge_Response *resp);
+
+/*
+ * Optional decode hooks of a subsystem. prepare is called right before the subsystem's request
+ * message is decoded, with field->pData pointing at it, typically to set up nanopb callbacks that
+ * decode straight into subsystem owned memory. discard is called when a request that went through
+ * prepare fails to decode and will never reach its handler.
+ *
+ * Every request of a batch is decoded before the first one is handled, so prepare is told when the
+ * request is part of one. It must not stage data outside of the request then, but install
+ * bridge_decode_batch_reject() for those fields instead.
+ */
+struct bridge_subsystem_decoder {
+    bool (*prepare)(pb_istream_t *stream, const pb_field_t *field, bool batched);
+    void (*discard)(const bridge_Request *req);
+    uint8_t subsystem_choice;
+};
+
+#define BRIDGE_SUBSYSTEM_DECODER(prefix, prepare_func, discard_func)                               \
+    STRUCT_SECTION_ITERABLE(bridge_subsystem_decoder, prefix##_subsystem_decoder) = {              \
+        .prepare = prepare_func,                                                                   \
+        .discard = discard_func,                                                                   \
+        .subsystem_choice = bridge_Request_##prefix##_tag,                                         \
+    };
+
+/**
+ * @brief nanopb decode callback for fields of a batched request that a subsystem decodes outside
+ * of the request. Skips the data and fails the request without running its handler.
+ */
+bool bridge_decode_batch_reject(pb_istream_t *stream, const pb_field_t *field, void **arg);
+
+/*
+ * A blob the host can read in chunks through Request.read_chunks, see bridge.ChunkRequest.
+ * read copies len bytes starting at offset into buf and returns 0 or a negative errno.
+ */
+struct bridge_blob_provider {
+    size_t (*size)(void);
+    int (*read)(size_t offset, uint8_t *buf, size_t len);
+    uint32_t blob_id;
+};
+
+#define BRIDGE_BLOB_PROVIDER(name, id, size_func, read_func)                                       \
+    STRUCT_SECTION_ITERABLE(bridge_blob_provider, name##_blob_provider) = {                        \
+        .size = size_func,                                                                         \
+        .read = read_func,                                                                         \
+        .blob_id = id,                                                                             \
+    };
+
 #define BRIDGE_RESPONSE(subsys, _type, ...)                                                        \
     ((bridge_Response){                                                                            \
+        .request_status = true,                                                                    \
         .which_subsystem = bridge_Response_##subsys##_tag,                                         \
         .subsystem =                                                                               \
             {                                                                                      \
@@ -59,17 +145,33 @@ struct bridge_subsystem_handler {
 
 #define BRIDGE_NOTIFICATION(subsys, _type, ...)                                                    \
     ((bridge_Notification){                                                                        \
-        .which_subsystem = bridge_Response_##subsys##_tag,                                         \
+        .which_subsystem = bridge_Notification_##subsys##_tag,                                     \
         .subsystem =                                                                               \
             {                                                                                      \
                 .subsys =                                                                          \
                     {                                                                              \
-                        .which_notification_type = bridge_##subsys##_Response_##_type##_tag,       \
+                        .which_notification_type = bridge_##subsys##_Notification_##_type##_tag,   \
                         .notification_type = {._type = __VA_ARGS__},                               \
                     },                                                                             \
             },                                                                                     \
     })
 
+enum bridge_notification_priority {
+    BRIDGE_NOTIFICATION_PRIORITY_LOW,
+    BRIDGE_NOTIFICATION_PRIORITY_HIGH,
+};
+
+/**
+ * @brief Encode a notification and queue it for the host. Safe to call from any thread, it never
+ * waits for the transport. Queued notifications are sent between responses, high priority ones
+ * first.
+ * @retval 0 if the notification has been queued.
+ * @retval -ENOMEM if the encoded notification exceeds CONFIG_ZMK_BRIDGE_NOTIFICATION_MAX_SIZE.
+ * @retval -EAGAIN if the queue for @p priority is full and the notification has been dropped.
+ */
+int bridge_notify(const bridge_Notification *notification,
+                  enum bridge_notification_priority priority);
+
 #define BRIDGE_RESPONSE_SIMPLE(status)                                                             \
     ((bridge_Response){                                                                            \
         .request_status = status,                                                                  \
@@ -0,0 +1,36 @@
+/*
+ * Copyright (c) 2025 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+#include <zephyr/kernel.h>
+
+/*
+ * In-memory Bridge transport, selected with ZMK_BRIDGE_TRANSPORT_LOOPBACK. Plays the host side of
+ * CONFIG_ZMK_BRIDGE_LOOPBACK_SESSIONS sessions, so tests and benchmarks can drive the real framing,
+ * decode and dispatch path without a wire. Data goes straight through the session's frame buffers
+ * and TX ring, semaphores are only used to wait for room or data. Each direction of a session is
+ * meant to be driven by a single thread.
+ */
+
+/**
+ * @brief Send framed bytes to the Bridge, as if they came from the host. Only the first frame in
+ * @p buf is guaranteed a frame buffer, so send one frame per call to get back-pressure.
+ * @param index The session, below CONFIG_ZMK_BRIDGE_LOOPBACK_SESSIONS.
+ * @param timeout How long to wait for a free frame buffer.
+ * @retval 0 once all of @p buf has been handed over.
+ * @retval -EAGAIN if no frame buffer became free in time.
+ * @retval -EINVAL if there is no such session.
+ */
+int bridge_loopback_send(uint8_t index, const uint8_t *buf, size_t len, k_timeout_t timeout);
+
+/**
+ * @brief Receive framed bytes sent by the Bridge.
+ * @param index The session, below CONFIG_ZMK_BRIDGE_LOOPBACK_SESSIONS.
+ * @param timeout How long to wait for data when none is queued.
+ * @retval The number of bytes copied to @p buf, 0 on timeout or if there is no such session.
+ */
+size_t bridge_loopback_receive(uint8_t index, uint8_t *buf, size_t len, k_timeout_t timeout);
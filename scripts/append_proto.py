@@ -12,8 +12,12 @@ def add_oneof(proto_file, oneof_name, new_field_type, new_field_name, target_mes
         def replacer(match):
             message_start, oneof_body, message_end = match.groups()
             field_pattern = r"=\s*(\d+);"
+            # Numbered within the oneof, so the tags of existing subsystems never change.
             indices = [int(x) for x in re.findall(field_pattern, oneof_body)]
             next_index = max(indices) + 1 if indices else 1
+            others = [int(x) for x in re.findall(field_pattern, message_start + message_end)]
+            if next_index in others:
+                raise ValueError(f"{message_name}: subsystem {new_field_name} would reuse field number {next_index}")
             new_line = f"        {new_field_type}.{message_name} {new_field_name} = {next_index};\n"
             return message_start + oneof_body + new_line + message_end
 
@@ -0,0 +1,99 @@
+import sys
+import os
+import re
+
+sys.dont_write_bytecode = True
+from append_proto import parse_module_proto
+
+HEADER = """/*
+ * Copyright (c) 2025 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+/* Generated by scripts/gen_dispatch_table.py from the merged proto files, do not edit. */
+
+#pragma once
+"""
+
+def parse_request_types(proto_file):
+    with open(proto_file, "r", encoding="utf-8") as f:
+        text = f.read()
+
+    pattern = r"message\s+Request\s*\{[\s\S]*?oneof\s+request_type\s*\{([\s\S]*?)\}"
+    match = re.search(pattern, text)
+    if not match:
+        return []
+
+    field_pattern = r"^\s*[\w.]+\s+(\w+)\s*=\s*\d+\s*;"
+    return re.findall(field_pattern, match.group(1), re.MULTILINE)
+
+def generate(proto_files):
+    externs = []
+    rows = []
+    table = []
+
+    for proto_file in proto_files:
+        module, name, messages = parse_module_proto(proto_file)
+        if module is None or "Request" not in messages:
+            continue
+
+        request_types = parse_request_types(proto_file)
+        if not request_types:
+            continue
+
+        entries = []
+        for request_type in request_types:
+            handler = f"{name}_subsystem_handler_{request_type}"
+            # Weak, so request types without a compiled-in handler resolve to NULL.
+            externs.append(f"extern struct bridge_subsystem_handler {handler} __weak;")
+            entries.append(f"    [bridge_{name}_Request_{request_type}_tag] = &{handler},")
+
+        rows.append(f"static const struct bridge_subsystem_handler *const bridge_dispatch_{name}[] = {{")
+        rows.extend(entries)
+        rows.append("};")
+        rows.append("")
+
+        table.append(f"    [bridge_Request_{name}_tag] =")
+        table.append("        {")
+        table.append(f"            .handlers = bridge_dispatch_{name},")
+        table.append(f"            .len = ARRAY_SIZE(bridge_dispatch_{name}),")
+        table.append(f"            .which_request_type_offset =")
+        table.append(f"                offsetof(bridge_Request, subsystem.{name}.which_request_type),")
+        table.append("        },")
+
+    lines = [HEADER]
+    lines.extend(externs)
+    lines.append("")
+    lines.extend(rows)
+    lines.append("static const struct bridge_dispatch_row bridge_dispatch_table[] = {")
+    lines.extend(table)
+    lines.append("};")
+    return "\n".join(lines) + "\n"
+
+def main():
+    if len(sys.argv) < 2:
+        print("Usage: <output_header_path> [module.proto_path...]")
+        sys.exit(1)
+
+    output_path = sys.argv[1]
+    proto_files = sys.argv[2:]
+
+    for proto_file in proto_files:
+        if not os.path.exists(proto_file):
+            print(f"Error: Proto file '{proto_file}' does not exist")
+            sys.exit(1)
+
+    text = generate(proto_files)
+
+    # Only touch the header when it changes to avoid needless rebuilds.
+    if os.path.exists(output_path):
+        with open(output_path, "r", encoding="utf-8") as f:
+            if f.read() == text:
+                return
+
+    with open(output_path, "w", encoding="utf-8") as f:
+        f.write(text)
+
+if __name__ == "__main__":
+   main()
@@ -0,0 +1,93 @@
+import sys
+import os
+import re
+import zlib
+import argparse
+
+HEADER = """/*
+ * Copyright (c) 2025 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+/* Generated by scripts/pack_proto_source.py from the merged proto files, do not edit. */
+
+#pragma once
+"""
+
+# Strings first, so comment markers inside them are left alone.
+TOKEN_PATTERN = re.compile(r'"(?:\\.|[^"\\\n])*"|\'(?:\\.|[^\'\\\n])*\'|//[^\n]*|/\*.*?\*/', re.DOTALL)
+# The subsystem markers read by scripts/append_proto.py.
+MARKER_PATTERN = re.compile(r'//\s*[^.\s]+\.[^\s\[]+\s*\[[^\]]+\]')
+
+def strip_comments(text):
+    def replace(match):
+        token = match.group(0)
+        if token.startswith(("\"", "'")) or MARKER_PATTERN.fullmatch(token):
+            return token
+        return ""
+
+    lines = (line.rstrip() for line in TOKEN_PATTERN.sub(replace, text).splitlines())
+    return "\n".join(line for line in lines if line) + "\n"
+
+def read_source(proto_files, keep_comments):
+    source = ""
+    for proto_file in proto_files:
+        with open(proto_file, "r", encoding="utf-8") as f:
+            text = f.read()
+        if not keep_comments:
+            text = strip_comments(text)
+        source += f"\nfile:{os.path.basename(proto_file)}\n" + text
+
+    return source.encode("utf-8")
+
+def format_bytes(data):
+    lines = []
+    for i in range(0, len(data), 16):
+        chunk = ", ".join(f"0x{b:02x}" for b in data[i:i + 16])
+        lines.append(f"    {chunk},")
+    return "\n".join(lines)
+
+def generate(source, compress):
+    # The hash always covers the plain text, so hosts can compare it with what they cached no
+    # matter how it was transferred.
+    source_hash = zlib.crc32(source) & 0xFFFFFFFF
+    payload = zlib.compress(source, 9) if compress else source
+
+    lines = [HEADER]
+    lines.append(f"#define BRIDGE_PROTO_SOURCE_COMPRESSED {1 if compress else 0}")
+    lines.append(f"#define BRIDGE_PROTO_SOURCE_PLAIN_SIZE {len(source)}")
+    lines.append("")
+    lines.append(f"static const uint32_t bridge_proto_source_hash = 0x{source_hash:08x};")
+    lines.append("static const uint8_t bridge_proto_source[] = {")
+    lines.append(format_bytes(payload))
+    lines.append("};")
+    return "\n".join(lines) + "\n", len(source), len(payload)
+
+def main():
+    parser = argparse.ArgumentParser(description="Pack the merged proto files into a C header")
+    parser.add_argument("--compress", action="store_true", help="zlib compress the source")
+    parser.add_argument("--keep-comments", action="store_true", help="embed the comments as well")
+    parser.add_argument("output", help="Output header path")
+    parser.add_argument("proto_files", nargs="+", help="Proto files, in the order to embed them")
+    args = parser.parse_args()
+
+    for proto_file in args.proto_files:
+        if not os.path.exists(proto_file):
+            print(f"Error: Proto file '{proto_file}' does not exist")
+            sys.exit(1)
+
+    text, plain_size, payload_size = generate(read_source(args.proto_files, args.keep_comments),
+                                                 args.compress)
+    print(f"Bridge proto source: {plain_size} bytes, embedded as {payload_size} bytes")
+
+    if os.path.exists(args.output):
+        with open(args.output, "r", encoding="utf-8") as f:
+            if f.read() == text:
+                return
+
+    with open(args.output, "w", encoding="utf-8") as f:
+        f.write(text)
+
+if __name__ == "__main__":
+   main()
@@ -0,0 +1,1170 @@
+/*
+ * Copyright (c) 2025 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <zephyr/init.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/sys/ring_buffer.h>
+#include <zephyr/sys/iterable_sections.h>
+
+#include <pb_decode.h>
+#include <pb_encode.h>
+
+#include <bridge_latency.h>
+#include <bridge_transport.h>
+#include <uart_framing.h>
+
+// gen/bridge_gen.h.in
+#include "bridge_gen.h"
+// scripts/pack_proto_source.py
+#include "bridge_source_gen.h"
+
+LOG_MODULE_REGISTER(zmk_bridge, CONFIG_ZMK_BRIDGE_LOG_LEVEL);
+
+#include <zmk/bridge.h>
+
+// scripts/gen_dispatch_table.py
+#include "bridge_dispatch_gen.h"
+
+// Sessions waiting for a worker, see session_schedule().
+static K_FIFO_DEFINE(bridge_ready_sessions);
+
+// Subsystem decoders and handlers keep their state in statics, so only one runs at a time,
+// whichever session the request came from.
+static K_MUTEX_DEFINE(bridge_handler_mutex);
+
+// Hands the session to a worker unless one already has it, safe from any context.
+static void session_schedule(const struct bridge_session *session) {
+    struct bridge_session_state *state = session->state;
+
+    if (atomic_cas(&state->scheduled, 0, 1)) {
+        k_fifo_put(&bridge_ready_sessions, state);
+    }
+}
+
+static void link_error(const struct bridge_session *session, bridge_NakReason reason) {
+    struct bridge_session_state *state = session->state;
+
+    atomic_inc(&state->link_errors[reason]);
+    atomic_or(&state->pending_naks, BIT(reason));
+    session_schedule(session);
+}
+
+struct bridge_batch {
+    uint8_t len;
+    // Bit n is set when requests[n] carried data its subsystem cannot take inside a batch.
+    uint32_t rejected;
+    bridge_Request requests[CONFIG_ZMK_BRIDGE_BATCH_MAX_SIZE];
+};
+
+// Requests are decoded right before they are handled under bridge_handler_mutex, so one batch is
+// all we ever need.
+static struct bridge_batch bridge_batch;
+
+static const struct bridge_subsystem_handler *
+find_subsystem_handler_for_choice(const bridge_Request *req) {
+    if (req->which_subsystem >= ARRAY_SIZE(bridge_dispatch_table)) {
+        return NULL;
+    }
+
+    const struct bridge_dispatch_row *row = &bridge_dispatch_table[req->which_subsystem];
+    const pb_size_t request =
+        *(const pb_size_t *)((const uint8_t *)req + row->which_request_type_offset);
+
+    return request < row->len ? row->handlers[request] : NULL;
+}
+
+#if IS_ENABLED(CONFIG_ZMK_BRIDGE_LATENCY_STATS)
+static void record_latency(const bridge_Request *req, const struct bridge_latency_stamps *stamps) {
+    uint8_t subsystem = 0;
+    uint8_t request;
+
+    if (req->has_batch) {
+        request = bridge_Request_batch_tag;
+    } else if (req->has_read_chunks) {
+        request = bridge_Request_read_chunks_tag;
+    } else if (req->has_set_framing) {
+        request = bridge_Request_set_framing_tag;
+    } else if (req->get_bridge_source) {
+        request = bridge_Request_get_bridge_source_tag;
+    } else if (req->get_bridge_info) {
+        request = bridge_Request_get_bridge_info_tag;
+    } else if (req->get_link_stats) {
+        request = bridge_Request_get_link_stats_tag;
+    } else if (req->get_telemetry) {
+        request = bridge_Request_get_telemetry_tag;
+    } else {
+        const struct bridge_subsystem_handler *handler = find_subsystem_handler_for_choice(req);
+        subsystem = req->which_subsystem;
+        request = handler ? handler->request_choice : 0;
+    }
+
+    bridge_latency_record(subsystem, request, stamps);
+}
+#else
+static inline void record_latency(const bridge_Request *req,
+                                  const struct bridge_latency_stamps *stamps) {}
+#endif // IS_ENABLED(CONFIG_ZMK_BRIDGE_LATENCY_STATS)
+
+#if IS_ENABLED(CONFIG_ZMK_BRIDGE_TELEMETRY)
+static void telemetry_peak(atomic_t *peak, atomic_val_t value) {
+    atomic_val_t old;
+
+    do {
+        old = atomic_get(peak);
+        if (value <= old) {
+            return;
+        }
+    } while (!atomic_cas(peak, old, value));
+}
+
+#define TELEMETRY_INC(_state, _counter) atomic_inc(&(_state)->telemetry._counter)
+#define TELEMETRY_PEAK(_state, _peak, _value) telemetry_peak(&(_state)->telemetry._peak, _value)
+#else
+#define TELEMETRY_INC(_state, _counter)
+#define TELEMETRY_PEAK(_state, _peak, _value)
+#endif // IS_ENABLED(CONFIG_ZMK_BRIDGE_TELEMETRY)
+
+static void tx_notify(const struct bridge_session *session, bool frame_done) {
+    if (frame_done || ring_buf_size_get(&session->state->tx_buf) >= session->mtu) {
+        session->api->tx_submit(session, frame_done);
+    }
+}
+
+uint32_t bridge_transport_tx_claim(const struct bridge_session *session, uint8_t **data,
+                                   uint32_t size) {
+    return ring_buf_get_claim(&session->state->tx_buf, data, size);
+}
+
+void bridge_transport_tx_finish(const struct bridge_session *session, uint32_t len) {
+    ring_buf_get_finish(&session->state->tx_buf, len);
+}
+
+static bool bridge_tx_buffer_write(pb_ostream_t *stream, const uint8_t *buf, size_t count) {
+    const struct bridge_session *session = stream->state;
+    struct bridge_session_state *state = session->state;
+    struct ring_buf *tx_buf = &state->tx_buf;
+
+    state->tx_check = uart_framing_check_update(state->tx_check, buf, count);
+    size_t written = 0;
+
+    while (written < count) {
+        uint8_t *write_buf;
+        uint32_t claim_len = ring_buf_put_claim(tx_buf, &write_buf, tx_buf->size);
+
+        if (claim_len == 0) {
+            session->api->tx_wait(session);
+            continue;
+        }
+
+        size_t consumed;
+        size_t write_len = uart_framing_encode(&state->tx_encoder, &buf[written], count - written,
+                                               &consumed, write_buf, claim_len);
+
+        ring_buf_put_finish(tx_buf, write_len);
+        TELEMETRY_PEAK(session->state, tx_buf_peak, ring_buf_size_get(tx_buf));
+        written += consumed;
+
+        tx_notify(session, false);
+    }
+
+    return true;
+}
+
+static pb_ostream_t pb_ostream_for_tx_buf(void *user_data) {
+    pb_ostream_t stream = {&bridge_tx_buffer_write, (void *)user_data, SIZE_MAX, 0};
+    return stream;
+}
+
+// Takes the transport and opens a frame, everything written to the stream becomes its data.
+static pb_ostream_t tx_frame_begin(const struct bridge_session *session) {
+    struct bridge_session_state *state = session->state;
+
+    k_mutex_lock(&state->tx_mutex, K_FOREVER);
+
+    uart_framing_encoder_init(&state->tx_encoder, state->tx_codec);
+    state->tx_check = uart_framing_check_init();
+
+    return pb_ostream_for_tx_buf((void *)session);
+}
+
+static void tx_frame_end(pb_ostream_t *stream) {
+    const struct bridge_session *session = stream->state;
+    struct bridge_session_state *state = session->state;
+    struct ring_buf *tx_buf = &state->tx_buf;
+
+#if UART_FRAMING_CHECK_LEN > 0
+    uint8_t trailer[UART_FRAMING_CHECK_LEN];
+    uart_framing_check_put(state->tx_check, trailer);
+    bridge_tx_buffer_write(stream, trailer, sizeof(trailer));
+#endif // UART_FRAMING_CHECK_LEN > 0
+
+    for (bool done = false; !done;) {
+        uint8_t *write_buf;
+        uint32_t claim_len = ring_buf_put_claim(tx_buf, &write_buf, tx_buf->size);
+
+        if (claim_len == 0) {
+            session->api->tx_wait(session);
+            continue;
+        }
+
+        size_t write_len = uart_framing_encode_end(&state->tx_encoder, write_buf, claim_len, &done);
+        ring_buf_put_finish(tx_buf, write_len);
+        TELEMETRY_PEAK(state, tx_buf_peak, ring_buf_size_get(tx_buf));
+    }
+
+    tx_notify(session, true);
+
+    k_mutex_unlock(&state->tx_mutex);
+}
+
+static int send_response(const struct bridge_session *session, const bridge_Response *resp) {
+    pb_ostream_t stream = tx_frame_begin(session);
+
+    /* Now we are ready to encode the message! */
+    bool status = pb_encode(&stream, &bridge_Response_msg, resp);
+
+    if (!status) {
+#if !IS_ENABLED(CONFIG_NANOPB_NO_ERRMSG)
+        LOG_ERR("Failed to encode the message %s", stream.errmsg);
+#endif // !IS_ENABLED(CONFIG_NANOPB_NO_ERRMSG)
+        TELEMETRY_INC(session->state, encode_failures);
+    }
+
+    // Closed either way, the host drops a truncated frame instead of waiting for its end.
+    tx_frame_end(&stream);
+    return status ? 0 : -EINVAL;
+}
+
+int bridge_notify(const bridge_Notification *notification,
+                  enum bridge_notification_priority priority) {
+    struct bridge_notification_frame frame;
+    pb_ostream_t stream = pb_ostream_from_buffer(frame.data, sizeof(frame.data));
+
+    // Encoded as a Response that only carries the notification field.
+    if (!pb_encode_tag(&stream, PB_WT_STRING, bridge_Response_notification_tag) ||
+        !pb_encode_submessage(&stream, bridge_Notification_fields, notification)) {
+        LOG_WRN("Notification does not fit in %d bytes", CONFIG_ZMK_BRIDGE_NOTIFICATION_MAX_SIZE);
+        return -ENOMEM;
+    }
+
+    frame.len = stream.bytes_written;
+
+    // Encoded once and queued for every session, each host gets all notifications.
+    int ret = 0;
+    STRUCT_SECTION_FOREACH(bridge_session, session) {
+        struct bridge_session_state *state = session->state;
+        const bool high = priority == BRIDGE_NOTIFICATION_PRIORITY_HIGH;
+        struct k_msgq *queue =
+            high ? &state->notification_high_queue : &state->notification_low_queue;
+
+        if (k_msgq_put(queue, &frame, K_NO_WAIT) < 0) {
+            LOG_WRN("Notification queue of %s is full, dropping notification", session->name);
+            TELEMETRY_INC(state, notifications_dropped);
+            ret = -EAGAIN;
+            continue;
+        }
+
+        if (high) {
+            TELEMETRY_PEAK(state, notification_high_peak, k_msgq_num_used_get(queue));
+        } else {
+            TELEMETRY_PEAK(state, notification_low_peak, k_msgq_num_used_get(queue));
+        }
+
+        session_schedule(session);
+    }
+
+    return ret;
+}
+
+static int send_notification_frame(const struct bridge_session *session,
+                                   const struct bridge_notification_frame *notification) {
+    pb_ostream_t stream = tx_frame_begin(session);
+
+    pb_write(&stream, notification->data, notification->len);
+
+    tx_frame_end(&stream);
+    return 0;
+}
+
+static void send_queued_notifications(const struct bridge_session *session, struct k_msgq *queue,
+                                      uint32_t max_count) {
+    struct bridge_notification_frame frame;
+
+    for (uint32_t i = 0; i < max_count && k_msgq_get(queue, &frame, K_NO_WAIT) == 0; i++) {
+        send_notification_frame(session, &frame);
+    }
+}
+
+static bool encode_get_bridge_source(pb_ostream_t *stream, const pb_field_t *field,
+                                     void *const *arg) {
+    if (!pb_encode_tag_for_field(stream, field)) {
+        return false;
+    }
+
+    return pb_encode_string(stream, bridge_proto_source, sizeof(bridge_proto_source));
+}
+
+static bool encode_bridge_version(pb_ostream_t *stream, const pb_field_t *field, void *const *arg) {
+    if (!pb_encode_tag_for_field(stream, field)) {
+        return false;
+    }
+
+    return pb_encode_string(stream, bridge_version, strlen(bridge_version));
+}
+
+static bool encode_module_names(pb_ostream_t *stream, const pb_field_t *field, void *const *arg) {
+    if (!pb_encode_tag_for_field(stream, field)) {
+        return false;
+    }
+
+    return pb_encode_string(stream, bridge_module_names, strlen(bridge_module_names));
+}
+
+static size_t bridge_source_size(void) { return sizeof(bridge_proto_source); }
+
+static int bridge_source_read(size_t offset, uint8_t *buf, size_t len) {
+    memcpy(buf, &bridge_proto_source[offset], len);
+    return 0;
+}
+
+BRIDGE_BLOB_PROVIDER(bridge_source, bridge_BlobId_BLOB_ID_BRIDGE_SOURCE, bridge_source_size,
+                     bridge_source_read);
+
+struct blob_chunk {
+    const struct bridge_blob_provider *provider;
+    size_t offset;
+    size_t len;
+};
+
+static bool encode_blob_chunk(pb_ostream_t *stream, const pb_field_t *field, void *const *arg) {
+    const struct blob_chunk *chunk = *arg;
+
+    if (!pb_encode_tag_for_field(stream, field) || !pb_encode_varint(stream, chunk->len)) {
+        return false;
+    }
+
+    // Sizing pass of the enclosing submessage, nothing needs to be read.
+    if (!stream->callback) {
+        return pb_write(stream, NULL, chunk->len);
+    }
+
+    uint8_t buf[32];
+    for (size_t done = 0; done < chunk->len;) {
+        const size_t len = MIN(sizeof(buf), chunk->len - done);
+
+        if (chunk->provider->read(chunk->offset + done, buf, len) < 0 ||
+            !pb_write(stream, buf, len)) {
+            return false;
+        }
+
+        done += len;
+    }
+
+    return true;
+}
+
+static const struct bridge_blob_provider *find_blob_provider(uint32_t blob_id) {
+    STRUCT_SECTION_FOREACH(bridge_blob_provider, provider) {
+        if (provider->blob_id == blob_id) {
+            return provider;
+        }
+    }
+
+    return NULL;
+}
+
+/*
+ * Answers a ChunkRequest with up to window frames, one chunk each, releasing the transport in
+ * between so urgent notifications are not held up by a large transfer.
+ */
+static void send_blob_chunks(const struct bridge_session *session, const bridge_Request *req) {
+    const bridge_ChunkRequest *chunk_req = &req->read_chunks;
+    const struct bridge_blob_provider *provider = find_blob_provider(chunk_req->blob_id);
+
+    if (!provider) {
+        LOG_WRN("No blob provider for id %d", chunk_req->blob_id);
+        bridge_Response resp = BRIDGE_RESPONSE_SIMPLE(false);
+        resp.request_id = req->request_id;
+        send_response(session, &resp);
+        return;
+    }
+
+    const size_t total_size = provider->size();
+    const size_t chunk_size = chunk_req->chunk_size == 0
+                                  ? CONFIG_ZMK_BRIDGE_CHUNK_MAX_SIZE
+                                  : MIN(chunk_req->chunk_size, CONFIG_ZMK_BRIDGE_CHUNK_MAX_SIZE);
+    const uint32_t window = chunk_req->window == 0
+                                ? CONFIG_ZMK_BRIDGE_CHUNK_MAX_WINDOW
+                                : MIN(chunk_req->window, CONFIG_ZMK_BRIDGE_CHUNK_MAX_WINDOW);
+
+    size_t offset = chunk_req->offset;
+    for (uint32_t i = 0; i < window; i++) {
+        struct blob_chunk chunk = {
+            .provider = provider,
+            .offset = offset,
+            .len = offset < total_size ? MIN(chunk_size, total_size - offset) : 0,
+        };
+
+        bridge_Response resp = bridge_Response_init_zero;
+        resp.request_id = req->request_id;
+        resp.request_status = true;
+        resp.has_chunk = true;
+        resp.chunk.blob_id = chunk_req->blob_id;
+        resp.chunk.offset = offset;
+        resp.chunk.total_size = total_size;
+        resp.chunk.data.funcs.encode = encode_blob_chunk;
+        resp.chunk.data.arg = &chunk;
+
+        int err = send_response(session, &resp);
+        if (err < 0) {
+            LOG_ERR("Failed to send blob chunk %d", err);
+            return;
+        }
+
+        offset += chunk.len;
+        if (offset >= total_size) {
+            return;
+        }
+
+        send_queued_notifications(session, &session->state->notification_high_queue, UINT32_MAX);
+    }
+}
+
+static bridge_LinkStats link_stats(const struct bridge_session *session) {
+    const struct bridge_session_state *state = session->state;
+    bridge_LinkStats stats = bridge_LinkStats_init_zero;
+
+    stats.rx_frames = atomic_get(&state->rx_frames);
+    stats.check_failures =
+        atomic_get(&state->link_errors[bridge_NakReason_NAK_REASON_CHECK_FAILED]);
+    stats.timeouts = atomic_get(&state->link_errors[bridge_NakReason_NAK_REASON_TIMEOUT]);
+    stats.oversized_frames =
+        atomic_get(&state->link_errors[bridge_NakReason_NAK_REASON_FRAME_TOO_LARGE]);
+    stats.overruns = atomic_get(&state->link_errors[bridge_NakReason_NAK_REASON_OVERRUN]);
+    stats.decode_failures =
+        atomic_get(&state->link_errors[bridge_NakReason_NAK_REASON_DECODE_FAILED]);
+    stats.aborted_frames =
+        atomic_get(&state->link_errors[bridge_NakReason_NAK_REASON_FRAME_ABORTED]);
+    return stats;
+}
+
+#if IS_ENABLED(CONFIG_ZMK_BRIDGE_TELEMETRY)
+static void telemetry_sample(const struct bridge_session *session, bridge_Telemetry *telemetry);
+#endif // IS_ENABLED(CONFIG_ZMK_BRIDGE_TELEMETRY)
+
+static bridge_Response handle_request(const struct bridge_session *session,
+                                      const bridge_Request *req);
+
+static bridge_Response handle_batch(const struct bridge_session *session,
+                                    const bridge_Request *req) {
+    struct bridge_batch *batch = req->batch.requests.arg;
+    bridge_BatchResponse batch_resp = bridge_BatchResponse_init_zero;
+    bool status = true;
+
+    for (int i = 0; batch && i < batch->len; i++) {
+        bridge_Response item_resp = BRIDGE_RESPONSE_SIMPLE(false);
+        if (batch->rejected & BIT(i)) {
+            LOG_WRN("Batched request %d carries data that is only accepted outside of a batch", i);
+        } else {
+            item_resp = handle_request(session, &batch->requests[i]);
+        }
+        batch_resp.executed++;
+
+        if (item_resp.request_status) {
+            batch_resp.status_bitmap |= BIT(i);
+        } else {
+            status = false;
+            if (req->batch.stop_on_failure) {
+                break;
+            }
+        }
+    }
+
+    bridge_Response resp = bridge_Response_init_zero;
+    resp.request_status = status;
+    resp.batch = batch_resp;
+    resp.has_batch = true;
+    return resp;
+}
+
+static bridge_Response handle_request(const struct bridge_session *session,
+                                      const bridge_Request *req) {
+    if (req->has_batch) {
+        return handle_batch(session, req);
+    }
+
+    if (req->get_bridge_source) {
+        bridge_Response resp = bridge_Response_init_zero;
+        resp.request_status = true;
+#if BRIDGE_PROTO_SOURCE_COMPRESSED
+        resp.bridge_source_compressed.funcs.encode = encode_get_bridge_source;
+#else
+        resp.bridge_source.funcs.encode = encode_get_bridge_source;
+#endif // BRIDGE_PROTO_SOURCE_COMPRESSED
+        return resp;
+    }
+
+    if (req->get_bridge_info) {
+        bridge_GetBridgeInfoResponse bridge_info = bridge_GetBridgeInfoResponse_init_zero;
+        bridge_info.device_id = bridge_device_id;
+        bridge_info.bridge_version.funcs.encode = encode_bridge_version;
+        bridge_info.module_names.funcs.encode = encode_module_names;
+        bridge_info.source_hash = bridge_proto_source_hash;
+        bridge_info.source_encoding = BRIDGE_PROTO_SOURCE_COMPRESSED
+                                          ? bridge_SourceEncoding_SOURCE_ENCODING_ZLIB
+                                          : bridge_SourceEncoding_SOURCE_ENCODING_PLAIN;
+        bridge_info.framing_codecs = BIT(bridge_FramingCodec_FRAMING_CODEC_ESCAPE);
+#if IS_ENABLED(CONFIG_ZMK_BRIDGE_FRAMING_COBS)
+        bridge_info.framing_codecs |= BIT(bridge_FramingCodec_FRAMING_CODEC_COBS);
+#endif // IS_ENABLED(CONFIG_ZMK_BRIDGE_FRAMING_COBS)
+#if IS_ENABLED(CONFIG_ZMK_BRIDGE_FRAME_CHECK_CRC32)
+        bridge_info.frame_check = bridge_FrameCheck_FRAME_CHECK_CRC32;
+#elif IS_ENABLED(CONFIG_ZMK_BRIDGE_FRAME_CHECK_CRC16)
+        bridge_info.frame_check = bridge_FrameCheck_FRAME_CHECK_CRC16;
+#endif // IS_ENABLED(CONFIG_ZMK_BRIDGE_FRAME_CHECK_CRC32)
+
+        bridge_Response resp = bridge_Response_init_zero;
+        resp.request_status = true;
+        resp.bridge_info = bridge_info;
+        resp.has_bridge_info = true;
+
+        return resp;
+    }
+
+    if (req->get_link_stats) {
+        // Stats of the link the request came in on.
+        bridge_Response resp = bridge_Response_init_zero;
+        resp.request_status = true;
+        resp.has_link_stats = true;
+        resp.link_stats = link_stats(session);
+        return resp;
+    }
+
+#if IS_ENABLED(CONFIG_ZMK_BRIDGE_TELEMETRY)
+    if (req->get_telemetry) {
+        bridge_Response resp = bridge_Response_init_zero;
+        resp.request_status = true;
+        resp.has_telemetry = true;
+        telemetry_sample(session, &resp.telemetry);
+        return resp;
+    }
+#endif // IS_ENABLED(CONFIG_ZMK_BRIDGE_TELEMETRY)
+
+    const struct bridge_subsystem_handler *handler = find_subsystem_handler_for_choice(req);
+    if (!handler) {
+        LOG_WRN("No handler found for choice %d", req->which_subsystem);
+        return BRIDGE_RESPONSE_SIMPLE(false);
+    }
+
+    if (handler->async_func) {
+        // Only reached from a batch, or when every completion token is in use.
+        LOG_WRN("Async handler for choice %d not started", req->which_subsystem);
+        return BRIDGE_RESPONSE_SIMPLE(false);
+    }
+
+    bridge_Response resp = handler->func(req);
+    return resp;
+}
+
+static const struct bridge_subsystem_decoder *find_decoder(pb_size_t subsystem_choice) {
+    STRUCT_SECTION_FOREACH(bridge_subsystem_decoder, decoder) {
+        if (decoder->subsystem_choice == subsystem_choice) {
+            return decoder;
+        }
+    }
+
+    return NULL;
+}
+
+static bool decode_batch_subsystem(pb_istream_t *stream, const pb_field_t *field, void **arg) {
+    const struct bridge_subsystem_decoder *decoder = find_decoder(field->tag);
+    return decoder ? decoder->prepare(stream, field, true) : true;
+}
+
+bool bridge_decode_batch_reject(pb_istream_t *stream, const pb_field_t *field, void **arg) {
+    // Requests are only counted once decoded, so len is the one being decoded.
+    bridge_batch.rejected |= BIT(bridge_batch.len);
+    return pb_read(stream, NULL, stream->bytes_left);
+}
+
+static bool decode_batch_request(pb_istream_t *stream, const pb_field_t *field, void **arg) {
+    struct bridge_batch *batch = *arg;
+
+    if (!batch) {
+        batch = &bridge_batch;
+        batch->len = 0;
+        batch->rejected = 0;
+        *arg = batch;
+    }
+
+    if (batch->len >= ARRAY_SIZE(batch->requests)) {
+        LOG_WRN("Batch exceeds %d requests", CONFIG_ZMK_BRIDGE_BATCH_MAX_SIZE);
+        return false;
+    }
+
+    bridge_Request *item = &batch->requests[batch->len];
+    *item = (bridge_Request)bridge_Request_init_zero;
+    item->cb_subsystem.funcs.decode = decode_batch_subsystem;
+
+    if (!pb_decode(stream, &bridge_Request_msg, item)) {
+        return false;
+    }
+
+    if (item->has_batch) {
+        LOG_WRN("Nested batches are not supported");
+        return false;
+    }
+
+    batch->len++;
+    return true;
+}
+
+static bool decode_subsystem(pb_istream_t *stream, const pb_field_t *field, void **arg) {
+    const struct bridge_subsystem_decoder *decoder = find_decoder(field->tag);
+    if (!decoder) {
+        return true;
+    }
+
+    // Remembered so a failed decode can be handed back to the subsystem.
+    *arg = (void *)decoder;
+    return decoder->prepare(stream, field, false);
+}
+
+struct bridge_completion {
+    struct k_work work;
+    const struct bridge_session *session;
+    const struct bridge_subsystem_handler *handler;
+    bridge_Request req;
+#if IS_ENABLED(CONFIG_ZMK_BRIDGE_LATENCY_STATS)
+    struct bridge_latency_stamps stamps;
+#endif // IS_ENABLED(CONFIG_ZMK_BRIDGE_LATENCY_STATS)
+};
+
+K_THREAD_STACK_DEFINE(bridge_async_work_q_stack, CONFIG_ZMK_BRIDGE_ASYNC_WORK_Q_STACK_SIZE);
+static struct k_work_q bridge_async_work_q;
+
+/*
+ * A static array rather than a k_mem_slab: the work queue still touches a work item after its
+ * handler returns, and by then the handler may have completed the request and released the token.
+ */
+static struct bridge_completion bridge_completions[CONFIG_ZMK_BRIDGE_ASYNC_MAX_PENDING];
+static ATOMIC_DEFINE(bridge_completions_used, CONFIG_ZMK_BRIDGE_ASYNC_MAX_PENDING);
+
+static void async_work_handler(struct k_work *work) {
+    struct bridge_completion *completion = CONTAINER_OF(work, struct bridge_completion, work);
+
+    completion->handler->async_func(&completion->req, completion);
+}
+
+static struct bridge_completion *completion_alloc(void) {
+    for (int i = 0; i < ARRAY_SIZE(bridge_completions); i++) {
+        if (!atomic_test_and_set_bit(bridge_completions_used, i)) {
+            return &bridge_completions[i];
+        }
+    }
+
+    return NULL;
+}
+
+void bridge_complete(struct bridge_completion *completion, const bridge_Response *resp) {
+    bridge_Response tagged = *resp;
+    tagged.request_id = completion->req.request_id;
+#if IS_ENABLED(CONFIG_ZMK_BRIDGE_LATENCY_STATS)
+    BRIDGE_LATENCY_STAMP(completion->stamps.handled);
+#endif // IS_ENABLED(CONFIG_ZMK_BRIDGE_LATENCY_STATS)
+
+    int err = send_response(completion->session, &tagged);
+    if (err < 0) {
+        LOG_ERR("Failed to send the async Bridge response %d", err);
+    }
+
+#if IS_ENABLED(CONFIG_ZMK_BRIDGE_LATENCY_STATS)
+    BRIDGE_LATENCY_STAMP(completion->stamps.responded);
+    record_latency(&completion->req, &completion->stamps);
+#endif // IS_ENABLED(CONFIG_ZMK_BRIDGE_LATENCY_STATS)
+
+    atomic_clear_bit(bridge_completions_used, completion - bridge_completions);
+}
+
+/*
+ * Hands a request with an asynchronous handler to the work queue, copying it out of the decode
+ * buffers first. Returns false if the request has to be handled synchronously.
+ */
+static bool start_async_request(const struct bridge_session *session, const bridge_Request *req,
+                                const struct bridge_latency_stamps *stamps) {
+    if (req->has_batch) {
+        return false;
+    }
+
+    const struct bridge_subsystem_handler *handler = find_subsystem_handler_for_choice(req);
+    if (!handler || !handler->async_func) {
+        return false;
+    }
+
+    struct bridge_completion *completion = completion_alloc();
+    if (!completion) {
+        LOG_WRN("%d async requests pending already", CONFIG_ZMK_BRIDGE_ASYNC_MAX_PENDING);
+        return false;
+    }
+
+    completion->session = session;
+    completion->handler = handler;
+    completion->req = *req;
+#if IS_ENABLED(CONFIG_ZMK_BRIDGE_LATENCY_STATS)
+    completion->stamps = *stamps;
+#endif // IS_ENABLED(CONFIG_ZMK_BRIDGE_LATENCY_STATS)
+    k_work_submit_to_queue(&bridge_async_work_q, &completion->work);
+    return true;
+}
+
+BUILD_ASSERT(UART_FRAMING_CODEC_ESCAPE == bridge_FramingCodec_FRAMING_CODEC_ESCAPE &&
+             UART_FRAMING_CODEC_COBS == bridge_FramingCodec_FRAMING_CODEC_COBS);
+
+/*
+ * The host waits for the response before it sends anything in the new codec, so the receive side
+ * switches right away, while the response itself still goes out in the old codec.
+ */
+static void switch_framing(const struct bridge_session *session, const bridge_Request *req) {
+    struct bridge_session_state *state = session->state;
+    const enum uart_framing_codec codec = req->set_framing.codec;
+    const bool supported = codec == UART_FRAMING_CODEC_ESCAPE ||
+                           (IS_ENABLED(CONFIG_ZMK_BRIDGE_FRAMING_COBS) &&
+                            codec == UART_FRAMING_CODEC_COBS);
+
+    if (supported) {
+        k_spinlock_key_t key = k_spin_lock(&state->rx_lock);
+        uart_framing_decoder_init(&state->rx_decoder, codec);
+        if (state->rx_frame) {
+            state->rx_frame->len = 0;
+        }
+        state->rx_drop_reason = bridge_NakReason_NAK_REASON_UNSPECIFIED;
+        k_spin_unlock(&state->rx_lock, key);
+    } else {
+        LOG_WRN("Unsupported framing codec %d", codec);
+    }
+
+    bridge_Response resp = BRIDGE_RESPONSE_SIMPLE(supported);
+    resp.request_id = req->request_id;
+    send_response(session, &resp);
+
+    if (supported) {
+        // Asynchronous completions may be sending on the session from another thread.
+        k_mutex_lock(&state->tx_mutex, K_FOREVER);
+        state->tx_codec = codec;
+        k_mutex_unlock(&state->tx_mutex);
+    }
+}
+
+static void send_pending_naks(const struct bridge_session *session) {
+    const atomic_val_t pending = atomic_clear(&session->state->pending_naks);
+
+    for (int reason = 0; reason < _bridge_NakReason_ARRAYSIZE; reason++) {
+        if (pending & BIT(reason)) {
+            bridge_Response resp = bridge_Response_init_zero;
+            resp.has_nak = true;
+            resp.nak.reason = reason;
+            send_response(session, &resp);
+        }
+    }
+}
+
+static void handle_frame(const struct bridge_session *session, struct bridge_rx_frame *frame) {
+    const bool check_ok = uart_framing_check_frame(frame->data, frame->len);
+    pb_istream_t stream =
+        pb_istream_from_buffer(frame->data, check_ok ? frame->len - UART_FRAMING_CHECK_LEN : 0);
+    bridge_Request req = bridge_Request_init_zero;
+    req.cb_subsystem.funcs.decode = decode_subsystem;
+    req.batch.requests.funcs.decode = decode_batch_request;
+    struct bridge_latency_stamps stamps;
+#if IS_ENABLED(CONFIG_ZMK_BRIDGE_LATENCY_STATS)
+    stamps.received = frame->received_cycles;
+#endif // IS_ENABLED(CONFIG_ZMK_BRIDGE_LATENCY_STATS)
+
+    // Held from decoding until the handler is done with the request.
+    k_mutex_lock(&bridge_handler_mutex, K_FOREVER);
+
+    bool status = check_ok && pb_decode(&stream, &bridge_Request_msg, &req);
+    BRIDGE_LATENCY_STAMP(stamps.decoded);
+
+    // Everything the request needs has been copied out of the frame by now.
+    k_mem_slab_free(&session->state->rx_frame_slab, frame);
+    if (session->api->rx_resume) {
+        session->api->rx_resume(session);
+    }
+
+    if (!check_ok) {
+        k_mutex_unlock(&bridge_handler_mutex);
+        LOG_WRN("Frame check failed");
+        link_error(session, bridge_NakReason_NAK_REASON_CHECK_FAILED);
+        return;
+    }
+
+    if (!status) {
+        LOG_DBG("Decode failed");
+        const struct bridge_subsystem_decoder *decoder = req.cb_subsystem.arg;
+        if (decoder && decoder->discard) {
+            decoder->discard(&req);
+        }
+        k_mutex_unlock(&bridge_handler_mutex);
+        link_error(session, bridge_NakReason_NAK_REASON_DECODE_FAILED);
+        return;
+    }
+
+    if (req.has_read_chunks) {
+        k_mutex_unlock(&bridge_handler_mutex);
+        BRIDGE_LATENCY_STAMP(stamps.handled);
+        send_blob_chunks(session, &req);
+    } else if (req.has_set_framing) {
+        k_mutex_unlock(&bridge_handler_mutex);
+        BRIDGE_LATENCY_STAMP(stamps.handled);
+        switch_framing(session, &req);
+    } else if (start_async_request(session, &req, &stamps)) {
+        // Recorded by bridge_complete().
+        k_mutex_unlock(&bridge_handler_mutex);
+        return;
+    } else {
+        bridge_Response resp = handle_request(session, &req);
+        resp.request_id = req.request_id;
+        BRIDGE_LATENCY_STAMP(stamps.handled);
+        // Response encoders only read constant data, so a slow host does not hold up the others.
+        k_mutex_unlock(&bridge_handler_mutex);
+
+        int err = send_response(session, &resp);
+        if (err < 0) {
+            LOG_ERR("Failed to send the Bridge response %d", err);
+        }
+    }
+
+    BRIDGE_LATENCY_STAMP(stamps.responded);
+    record_latency(&req, &stamps);
+}
+
+static bool session_has_work(struct bridge_session_state *state) {
+    return atomic_get(&state->pending_naks) != 0 ||
+           k_msgq_num_used_get(&state->notification_high_queue) > 0 ||
+           k_msgq_num_used_get(&state->rx_frame_queue) > 0 ||
+           k_msgq_num_used_get(&state->notification_low_queue) > 0;
+}
+
+static void session_service(const struct bridge_session *session) {
+    struct bridge_session_state *state = session->state;
+
+    // NAKs go out first so the host can retransmit as early as possible. Notifications go out
+    // between responses: all urgent ones, then at most one request and one low priority
+    // notification per round so neither can starve the other.
+    send_pending_naks(session);
+    send_queued_notifications(session, &state->notification_high_queue, UINT32_MAX);
+
+    struct bridge_rx_frame *frame;
+    if (k_msgq_get(&state->rx_frame_queue, &frame, K_NO_WAIT) == 0) {
+        handle_frame(session, frame);
+    }
+
+    send_queued_notifications(session, &state->notification_low_queue, 1);
+}
+
+/*
+ * Workers take one round of a session at a time. A session is only ever queued once, so its
+ * requests are handled in order, while other sessions are served by the other workers.
+ */
+static void bridge_worker_main(void *p1, void *p2, void *p3) {
+    for (;;) {
+        struct bridge_session_state *state = k_fifo_get(&bridge_ready_sessions, K_FOREVER);
+
+        session_service(state->session);
+
+        // Anything that arrived after the last check of its queue finds the flag still set, so
+        // look again once it is cleared.
+        atomic_clear(&state->scheduled);
+        if (session_has_work(state)) {
+            session_schedule(state->session);
+        }
+    }
+}
+
+#define BRIDGE_WORKER_DEFINE(n, _)                                                                 \
+    K_THREAD_DEFINE(bridge_worker_##n, CONFIG_ZMK_BRIDGE_THREAD_STACK_SIZE, bridge_worker_main,    \
+                    NULL, NULL, NULL, K_LOWEST_APPLICATION_THREAD_PRIO, 0, 0);
+
+LISTIFY(CONFIG_ZMK_BRIDGE_WORKER_COUNT, BRIDGE_WORKER_DEFINE, ())
+
+static bool rx_in_frame(const struct bridge_session_state *state) {
+    return state->rx_decoder.state == FRAMING_STATE_AWAITING_DATA ||
+           state->rx_decoder.state == FRAMING_STATE_ESCAPED;
+}
+
+static void rx_frame_reset(struct bridge_session_state *state) {
+    if (state->rx_frame) {
+        state->rx_frame->len = 0;
+    }
+    state->rx_drop_reason = bridge_NakReason_NAK_REASON_UNSPECIFIED;
+}
+
+static bool rx_frame_alloc(struct bridge_session_state *state) {
+    void *frame;
+
+    if (k_mem_slab_alloc(&state->rx_frame_slab, &frame, K_NO_WAIT) < 0) {
+        return false;
+    }
+
+    state->rx_frame = frame;
+    state->rx_frame->len = 0;
+    TELEMETRY_PEAK(state, rx_frames_peak,
+                   CONFIG_ZMK_BRIDGE_RX_FRAME_COUNT -
+                       k_mem_slab_num_free_get(&state->rx_frame_slab));
+    // Picking up in the middle of a frame, its start is already lost.
+    state->rx_drop_reason = rx_in_frame(state) ? bridge_NakReason_NAK_REASON_OVERRUN
+                                               : bridge_NakReason_NAK_REASON_UNSPECIFIED;
+    return true;
+}
+
+bool bridge_transport_rx_ready(const struct bridge_session *session) {
+    struct bridge_session_state *state = session->state;
+
+    k_spinlock_key_t key = k_spin_lock(&state->rx_lock);
+    bool ready = state->rx_frame || rx_frame_alloc(state);
+    k_spin_unlock(&state->rx_lock, key);
+
+    return ready;
+}
+
+#if CONFIG_ZMK_BRIDGE_RX_TIMEOUT_MS > 0
+static void rx_timeout_expired(struct k_timer *timer) {
+    struct bridge_session_state *state = CONTAINER_OF(timer, struct bridge_session_state, rx_timer);
+    k_spinlock_key_t key = k_spin_lock(&state->rx_lock);
+
+    if (rx_in_frame(state)) {
+        LOG_WRN("%s timed out in the middle of a received frame", state->session->name);
+        state->rx_decoder.state = FRAMING_STATE_IDLE;
+        rx_frame_reset(state);
+        link_error(state->session, bridge_NakReason_NAK_REASON_TIMEOUT);
+    }
+
+    k_spin_unlock(&state->rx_lock, key);
+}
+#endif // CONFIG_ZMK_BRIDGE_RX_TIMEOUT_MS > 0
+
+/*
+ * Deframes received bytes into the current frame buffer and queues every complete frame for a
+ * worker, so the session is only scheduled once per frame. Frames that do not fit in a frame
+ * buffer, or that start while every frame buffer is in use, are dropped as a whole and NAKed.
+ */
+void bridge_transport_rx(const struct bridge_session *session, const uint8_t *data, size_t len) {
+    struct bridge_session_state *state = session->state;
+    uint8_t discard[16];
+    k_spinlock_key_t key = k_spin_lock(&state->rx_lock);
+
+    while (len > 0) {
+        if (!state->rx_frame) {
+            rx_frame_alloc(state);
+        }
+
+        struct bridge_rx_frame *frame = state->rx_drop_reason ? NULL : state->rx_frame;
+        uint8_t *out = frame ? &frame->data[frame->len] : discard;
+        size_t out_len = frame ? sizeof(frame->data) - frame->len : sizeof(discard);
+
+        size_t consumed;
+        size_t produced =
+            uart_framing_decode(&state->rx_decoder, data, len, &consumed, out, out_len);
+        data += consumed;
+        len -= consumed;
+
+        if (frame) {
+#if IS_ENABLED(CONFIG_ZMK_BRIDGE_LATENCY_STATS)
+            if (frame->len == 0 && produced > 0) {
+                frame->received_cycles = k_cycle_get_32();
+            }
+#endif // IS_ENABLED(CONFIG_ZMK_BRIDGE_LATENCY_STATS)
+            frame->len += produced;
+        } else if (produced > 0 && !state->rx_drop_reason) {
+            state->rx_drop_reason = bridge_NakReason_NAK_REASON_OVERRUN;
+        }
+
+        switch (state->rx_decoder.state) {
+        case FRAMING_STATE_EOF:
+            if (frame) {
+                // Never full, there are as many queue slots as frame buffers.
+                k_msgq_put(&state->rx_frame_queue, &frame, K_NO_WAIT);
+                atomic_inc(&state->rx_frames);
+                state->rx_frame = NULL;
+                session_schedule(session);
+            } else if (state->rx_drop_reason) {
+                LOG_WRN("Dropped a received frame");
+                link_error(session, state->rx_drop_reason);
+            }
+            state->rx_decoder.state = FRAMING_STATE_IDLE;
+            rx_frame_reset(state);
+            break;
+        case FRAMING_STATE_ERR:
+            // Cut short by the start of the next frame, which is received right away.
+            LOG_WRN("Received frame was aborted");
+            link_error(session, state->rx_drop_reason ? state->rx_drop_reason
+                                                      : bridge_NakReason_NAK_REASON_FRAME_ABORTED);
+            rx_frame_reset(state);
+            uart_framing_decoder_resync(&state->rx_decoder);
+            break;
+        default:
+            if (frame && frame->len > CONFIG_ZMK_BRIDGE_RX_FRAME_SIZE) {
+                LOG_WRN("Received frame exceeds %d bytes", CONFIG_ZMK_BRIDGE_RX_FRAME_SIZE);
+                state->rx_drop_reason = bridge_NakReason_NAK_REASON_FRAME_TOO_LARGE;
+            }
+            break;
+        }
+    }
+
+#if CONFIG_ZMK_BRIDGE_RX_TIMEOUT_MS > 0
+    if (rx_in_frame(state)) {
+        k_timer_start(&state->rx_timer, K_MSEC(CONFIG_ZMK_BRIDGE_RX_TIMEOUT_MS), K_NO_WAIT);
+    } else {
+        k_timer_stop(&state->rx_timer);
+    }
+#endif // CONFIG_ZMK_BRIDGE_RX_TIMEOUT_MS > 0
+
+    k_spin_unlock(&state->rx_lock, key);
+}
+
+static int bridge_sessions_init(void) {
+    STRUCT_SECTION_FOREACH(bridge_session, session) {
+        struct bridge_session_state *state = session->state;
+        const struct bridge_session_buffers *buffers = &session->buffers;
+
+        state->session = session;
+        k_mem_slab_init(&state->rx_frame_slab, buffers->rx_frames, sizeof(struct bridge_rx_frame),
+                        CONFIG_ZMK_BRIDGE_RX_FRAME_COUNT);
+        k_msgq_init(&state->rx_frame_queue, buffers->rx_frame_queue,
+                    sizeof(struct bridge_rx_frame *), CONFIG_ZMK_BRIDGE_RX_FRAME_COUNT);
+        ring_buf_init(&state->tx_buf, CONFIG_ZMK_BRIDGE_TX_BUF_SIZE, buffers->tx);
+        k_mutex_init(&state->tx_mutex);
+        k_msgq_init(&state->notification_high_queue, buffers->notification_high_queue,
+                    sizeof(struct bridge_notification_frame),
+                    CONFIG_ZMK_BRIDGE_NOTIFICATION_HIGH_QUEUE_SIZE);
+        k_msgq_init(&state->notification_low_queue, buffers->notification_low_queue,
+                    sizeof(struct bridge_notification_frame),
+                    CONFIG_ZMK_BRIDGE_NOTIFICATION_LOW_QUEUE_SIZE);
+#if CONFIG_ZMK_BRIDGE_RX_TIMEOUT_MS > 0
+        k_timer_init(&state->rx_timer, rx_timeout_expired, NULL);
+#endif // CONFIG_ZMK_BRIDGE_RX_TIMEOUT_MS > 0
+
+        int err = session->api->init(session);
+        if (err < 0) {
+            LOG_ERR("Failed to start the %s Bridge session %d", session->name, err);
+        }
+    }
+
+    return 0;
+}
+
+SYS_INIT(bridge_sessions_init, POST_KERNEL, CONFIG_KERNEL_INIT_PRIORITY_DEFAULT);
+
+static int bridge_async_init(void) {
+    for (int i = 0; i < ARRAY_SIZE(bridge_completions); i++) {
+        k_work_init(&bridge_completions[i].work, async_work_handler);
+    }
+
+    const struct k_work_queue_config config = {.name = "bridge_async"};
+    k_work_queue_start(&bridge_async_work_q, bridge_async_work_q_stack,
+                       K_THREAD_STACK_SIZEOF(bridge_async_work_q_stack),
+                       K_LOWEST_APPLICATION_THREAD_PRIO, &config);
+    return 0;
+}
+
+SYS_INIT(bridge_async_init, POST_KERNEL, CONFIG_KERNEL_INIT_PRIORITY_DEFAULT);
+
+#if IS_ENABLED(CONFIG_ZMK_BRIDGE_TELEMETRY)
+static void stack_usage(struct k_thread *thread, bridge_StackUsage *usage) {
+    size_t unused;
+
+    if (k_thread_stack_space_get(thread, &unused) < 0) {
+        return;
+    }
+
+    const char *name = k_thread_name_get(thread);
+    if (name) {
+        strncpy(usage->name, name, sizeof(usage->name) - 1);
+    }
+
+    usage->size = thread->stack_info.size;
+    usage->peak_used = thread->stack_info.size - unused;
+}
+
+#define BRIDGE_WORKER_THREAD(n, _) bridge_worker_##n
+
+static void telemetry_sample(const struct bridge_session *session, bridge_Telemetry *telemetry) {
+    struct bridge_session_state *state = session->state;
+
+    telemetry->has_link_stats = true;
+    telemetry->link_stats = link_stats(session);
+    telemetry->encode_failures = atomic_get(&state->telemetry.encode_failures);
+    telemetry->notifications_dropped = atomic_get(&state->telemetry.notifications_dropped);
+    telemetry->tx_buf_peak = atomic_get(&state->telemetry.tx_buf_peak);
+    telemetry->tx_buf_size = CONFIG_ZMK_BRIDGE_TX_BUF_SIZE;
+    telemetry->rx_frames_peak = atomic_get(&state->telemetry.rx_frames_peak);
+    telemetry->rx_frame_count = CONFIG_ZMK_BRIDGE_RX_FRAME_COUNT;
+    telemetry->notification_high_peak = atomic_get(&state->telemetry.notification_high_peak);
+    telemetry->notification_low_peak = atomic_get(&state->telemetry.notification_low_peak);
+
+    const k_tid_t workers[] = {LISTIFY(CONFIG_ZMK_BRIDGE_WORKER_COUNT, BRIDGE_WORKER_THREAD, (, ))};
+    struct k_thread *threads[ARRAY_SIZE(telemetry->stacks)];
+    size_t count = 0;
+
+    for (int i = 0; i < ARRAY_SIZE(workers) && count < ARRAY_SIZE(threads); i++) {
+        threads[count++] = workers[i];
+    }
+
+    if (count < ARRAY_SIZE(threads)) {
+        threads[count++] = &bridge_async_work_q.thread;
+    }
+
+    STRUCT_SECTION_FOREACH(bridge_session, other) {
+        if (other->api->rx_thread && count < ARRAY_SIZE(threads)) {
+            threads[count++] = other->api->rx_thread(other);
+        }
+    }
+
+    for (size_t i = 0; i < count; i++) {
+        stack_usage(threads[i], &telemetry->stacks[i]);
+    }
+    telemetry->stacks_count = count;
+}
+
+#if CONFIG_ZMK_BRIDGE_TELEMETRY_LOG_INTERVAL > 0
+static void telemetry_log(struct k_work *work);
+
+static K_WORK_DELAYABLE_DEFINE(telemetry_log_work, telemetry_log);
+
+static void telemetry_log(struct k_work *work) {
+    bridge_Telemetry telemetry = bridge_Telemetry_init_zero;
+
+    STRUCT_SECTION_FOREACH(bridge_session, session) {
+        telemetry = (bridge_Telemetry)bridge_Telemetry_init_zero;
+        telemetry_sample(session, &telemetry);
+
+        LOG_INF("%s: TX %u/%u, RX frames %u/%u, notifications %u/%u, overruns %u, decode "
+                "failures %u, encode failures %u, dropped notifications %u",
+                session->name, telemetry.tx_buf_peak, telemetry.tx_buf_size,
+                telemetry.rx_frames_peak, telemetry.rx_frame_count,
+                telemetry.notification_high_peak, telemetry.notification_low_peak,
+                telemetry.link_stats.overruns, telemetry.link_stats.decode_failures,
+                telemetry.encode_failures, telemetry.notifications_dropped);
+    }
+
+    // Threads are the same for every session, the last sample has them all.
+    for (int i = 0; i < telemetry.stacks_count; i++) {
+        LOG_INF("%s stack: %u/%u", telemetry.stacks[i].name, telemetry.stacks[i].peak_used,
+                telemetry.stacks[i].size);
+    }
+
+    k_work_schedule(&telemetry_log_work, K_SECONDS(CONFIG_ZMK_BRIDGE_TELEMETRY_LOG_INTERVAL));
+}
+
+static int telemetry_log_init(void) {
+    k_work_schedule(&telemetry_log_work, K_SECONDS(CONFIG_ZMK_BRIDGE_TELEMETRY_LOG_INTERVAL));
+    return 0;
+}
+
+SYS_INIT(telemetry_log_init, APPLICATION, CONFIG_APPLICATION_INIT_PRIORITY);
+#endif // CONFIG_ZMK_BRIDGE_TELEMETRY_LOG_INTERVAL > 0
+#endif // IS_ENABLED(CONFIG_ZMK_BRIDGE_TELEMETRY)
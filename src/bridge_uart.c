@@ -1,310 +0,0 @@
-/*
- * Copyright (c) 2025 The ZMK Contributors
- *
- * SPDX-License-Identifier: MIT
- */
-
-#include <zephyr/drivers/uart.h>
-#include <zephyr/init.h>
-#include <zephyr/logging/log.h>
-#include <zephyr/sys/ring_buffer.h>
-#include <zephyr/sys/iterable_sections.h>
-#include <zephyr/debug/thread_analyzer.h>
-
-#include <pb_decode.h>
-#include <pb_encode.h>
-
-#include <uart_framing.h>
-
-// gen/bridge_gen.h.in
-#include "bridge_gen.h"
-
-LOG_MODULE_REGISTER(zmk_bridge, CONFIG_ZMK_BRIDGE_LOG_LEVEL);
-
-#include <zmk/bridge.h>
-
-#define UART_DEVICE_NODE DT_CHOSEN(zmk_bridge_uart)
-
-static const struct device *const uart_dev = DEVICE_DT_GET(UART_DEVICE_NODE);
-
-RING_BUF_DECLARE(bridge_rx_buf, CONFIG_ZMK_BRIDGE_RX_BUF_SIZE);
-RING_BUF_DECLARE(bridge_tx_buf, CONFIG_ZMK_BRIDGE_TX_BUF_SIZE);
-
-static K_SEM_DEFINE(bridge_rx_sem, 0, 1);
-static K_MUTEX_DEFINE(bridge_transport_mutex);
-
-static enum uart_framing_state bridge_framing_state;
-
-static struct bridge_subsystem_handler *
-find_subsystem_handler_for_choice(const bridge_Request *req) {
-    const uint8_t subsystem = req->which_subsystem;
-    STRUCT_SECTION_FOREACH(bridge_subsystem_handler, sub) {
-        if (sub->subsystem_choice == subsystem &&
-            sub->bridge_request_id(req) == sub->request_choice) {
-            return sub;
-        }
-    }
-
-    return NULL;
-}
-
-static void tx_notify(struct ring_buf *tx_ring_buf, size_t written, bool msg_done,
-                      void *user_data) {
-    if (msg_done || (ring_buf_size_get(tx_ring_buf) > (ring_buf_capacity_get(tx_ring_buf) / 2))) {
-        struct ring_buf *tx_buf = &bridge_tx_buf;
-        uint8_t *buf;
-        uint32_t claim_len;
-        while ((claim_len = ring_buf_get_claim(tx_buf, &buf, tx_buf->size)) > 0) {
-            for (int i = 0; i < claim_len; i++) {
-                uart_poll_out(uart_dev, buf[i]);
-            }
-
-            ring_buf_get_finish(tx_buf, claim_len);
-        }
-    }
-}
-
-static bool bridge_read_cb(pb_istream_t *stream, uint8_t *buf, size_t count) {
-    uint32_t write_offset = 0;
-
-    do {
-        uint8_t *buffer;
-        uint32_t len = ring_buf_get_claim(&bridge_rx_buf, &buffer, count);
-
-        if (len > 0) {
-            for (int i = 0; i < len; i++) {
-                if (uart_framing_process_byte(&bridge_framing_state,
-                                              buffer[i])) { // get it from studio
-                    buf[write_offset++] = buffer[i];
-                }
-            }
-        } else {
-            k_sem_take(&bridge_rx_sem, K_FOREVER);
-        }
-
-        ring_buf_get_finish(&bridge_rx_buf, len);
-    } while (write_offset < count && bridge_framing_state != FRAMING_STATE_EOF);
-
-    if (bridge_framing_state == FRAMING_STATE_EOF) {
-        stream->bytes_left = 0;
-        return false;
-    } else {
-        return true;
-    }
-}
-
-static bool bridge_tx_buffer_write(pb_ostream_t *stream, const uint8_t *buf, size_t count) {
-    void *user_data = stream->state;
-    size_t written = 0;
-
-    bool escape_byte_already_written = false;
-    do {
-        uint32_t write_idx = 0;
-
-        uint8_t *write_buf;
-        uint32_t claim_len = ring_buf_put_claim(&bridge_tx_buf, &write_buf, count - written);
-
-        if (claim_len == 0) {
-            continue;
-        }
-
-        int escapes_written = 0;
-        for (int i = 0; i < claim_len && write_idx < claim_len; i++) {
-            uint8_t b = buf[written + i];
-            switch (b) {
-            case FRAMING_EOF:
-            case FRAMING_ESC:
-            case FRAMING_SOF:
-                // Care to be taken. We may need to write the escape byte,
-                // but that's the last available spot for this claim, so we track
-                // if the escape has already been written in the previous iteration
-                // of our loop.
-                if (!escape_byte_already_written) {
-                    escapes_written++;
-                    write_buf[write_idx++] = FRAMING_ESC;
-                    escape_byte_already_written = true;
-                    if (write_idx >= claim_len) {
-                        LOG_WRN("Skipping on, no room to write escape and real byte");
-                        continue;
-                    }
-                }
-            default:
-                write_buf[write_idx++] = b;
-                escape_byte_already_written = false;
-                break;
-            }
-        }
-
-        ring_buf_put_finish(&bridge_tx_buf, write_idx);
-
-        written += (write_idx - escapes_written);
-
-        tx_notify(&bridge_tx_buf, write_idx, false, user_data);
-    } while (written < count);
-
-    return true;
-}
-
-static pb_istream_t pb_istream_for_rx_ring_buf() {
-    pb_istream_t stream = {&bridge_read_cb, NULL, SIZE_MAX};
-    return stream;
-}
-
-static pb_ostream_t pb_ostream_for_tx_buf(void *user_data) {
-    pb_ostream_t stream = {&bridge_tx_buffer_write, (void *)user_data, SIZE_MAX, 0};
-    return stream;
-}
-
-static int send_response(const bridge_Response *resp) {
-    k_mutex_lock(&bridge_transport_mutex, K_FOREVER);
-
-    void *user_data = NULL;
-    pb_ostream_t stream = pb_ostream_for_tx_buf(user_data);
-
-    uint8_t framing_byte = FRAMING_SOF;
-    ring_buf_put(&bridge_tx_buf, &framing_byte, 1);
-
-    tx_notify(&bridge_tx_buf, 1, false, user_data);
-
-    /* Now we are ready to encode the message! */
-    bool status = pb_encode(&stream, &bridge_Response_msg, resp);
-
-    if (!status) {
-#if !IS_ENABLED(CONFIG_NANOPB_NO_ERRMSG)
-        LOG_ERR("Failed to encode the message %s", stream.errmsg);
-#endif // !IS_ENABLED(CONFIG_NANOPB_NO_ERRMSG)
-        return -EINVAL;
-    }
-
-    framing_byte = FRAMING_EOF;
-    ring_buf_put(&bridge_tx_buf, &framing_byte, 1);
-
-    tx_notify(&bridge_tx_buf, 1, true, user_data);
-    k_mutex_unlock(&bridge_transport_mutex);
-    return 0;
-}
-
-static bool encode_get_bridge_source(pb_ostream_t *stream, const pb_field_t *field,
-                                     void *const *arg) {
-    if (!pb_encode_tag_for_field(stream, field)) {
-        return false;
-    }
-
-    return pb_encode_string(stream, bridge_proto_source, strlen(bridge_proto_source));
-}
-
-static bool encode_bridge_version(pb_ostream_t *stream, const pb_field_t *field, void *const *arg) {
-    if (!pb_encode_tag_for_field(stream, field)) {
-        return false;
-    }
-
-    return pb_encode_string(stream, bridge_version, strlen(bridge_version));
-}
-
-static bool encode_module_names(pb_ostream_t *stream, const pb_field_t *field, void *const *arg) {
-    if (!pb_encode_tag_for_field(stream, field)) {
-        return false;
-    }
-
-    return pb_encode_string(stream, bridge_module_names, strlen(bridge_module_names));
-}
-
-static bridge_Response handle_request(const bridge_Request *req) {
-
-    if (req->get_bridge_source) {
-        bridge_Response resp = bridge_Response_init_zero;
-        resp.request_status = true;
-        resp.bridge_source.funcs.encode = encode_get_bridge_source;
-        return resp;
-    }
-
-    if (req->get_bridge_info) {
-        bridge_GetBridgeInfoResponse bridge_info = bridge_GetBridgeInfoResponse_init_zero;
-        bridge_info.device_id = bridge_device_id;
-        bridge_info.bridge_version.funcs.encode = encode_bridge_version;
-        bridge_info.module_names.funcs.encode = encode_module_names;
-
-        bridge_Response resp = bridge_Response_init_zero;
-        resp.request_status = true;
-        resp.bridge_info = bridge_info;
-        resp.has_bridge_info = true;
-
-        return resp;
-    }
-
-    struct bridge_subsystem_handler *handler = find_subsystem_handler_for_choice(req);
-    if (!handler) {
-        LOG_WRN("No handler found for choice %d", req->which_subsystem);
-        return BRIDGE_RESPONSE_SIMPLE(false);
-    }
-
-    bridge_Response resp = handler->func(req);
-    return resp;
-}
-
-static void bridge_main(void) {
-    for (;;) {
-        pb_istream_t stream = pb_istream_for_rx_ring_buf();
-        bridge_Request req = bridge_Request_init_zero;
-#if IS_ENABLED(CONFIG_THREAD_ANALYZER)
-        thread_analyzer_print();
-#endif // IS_ENABLED(CONFIG_THREAD_ANALYZER)
-        bool status = pb_decode(&stream, &bridge_Request_msg, &req);
-
-        bridge_framing_state = FRAMING_STATE_IDLE;
-
-        if (status) {
-            bridge_Response resp = handle_request(&req);
-
-            int err = send_response(&resp);
-#if IS_ENABLED(CONFIG_THREAD_ANALYZER)
-            thread_analyzer_print();
-#endif // IS_ENABLED(CONFIG_THREAD_ANALYZER)
-            if (err < 0) {
-                LOG_ERR("Failed to send the Bridge response %d", err);
-            }
-        } else {
-            LOG_DBG("Decode failed");
-        }
-    }
-}
-
-K_THREAD_DEFINE(bridge_thread, CONFIG_ZMK_BRIDGE_THREAD_STACK_SIZE, bridge_main, NULL, NULL, NULL,
-                K_LOWEST_APPLICATION_THREAD_PRIO, 0, 0);
-
-static void uart_rx_main(void) {
-    for (;;) {
-        uint8_t *buf;
-        struct ring_buf *ring_buf = &bridge_rx_buf;
-        uint32_t claim_len = ring_buf_put_claim(ring_buf, &buf, 1);
-
-        if (claim_len < 1) {
-            LOG_WRN("NO CLAIM ABLE TO BE HAD");
-            k_sleep(K_MSEC(1));
-            continue;
-        }
-
-        if (uart_poll_in(uart_dev, buf) < 0) {
-            ring_buf_put_finish(ring_buf, 0);
-            k_sleep(K_MSEC(1));
-        } else {
-            ring_buf_put_finish(ring_buf, 1);
-            k_sem_give(&bridge_rx_sem);
-        }
-    }
-}
-
-K_THREAD_DEFINE(uart_transport_read_thread, CONFIG_ZMK_BRIDGE_TRANSPORT_UART_RX_STACK_SIZE,
-                uart_rx_main, NULL, NULL, NULL, K_LOWEST_APPLICATION_THREAD_PRIO, 0, 0);
-
-static int uart_bridge_interface_init(void) {
-    if (!device_is_ready(uart_dev)) {
-        LOG_ERR("UART device not found!");
-        return -ENODEV;
-    }
-
-    k_thread_resume(uart_transport_read_thread);
-    return 0;
-}
-
-SYS_INIT(uart_bridge_interface_init, POST_KERNEL, CONFIG_KERNEL_INIT_PRIORITY_DEFAULT);
@@ -9,6 +9,9 @@
 #include <zephyr/logging/log.h>
 #include <zephyr/drivers/hwinfo.h>
 
+#include <bridge_latency.h>
+#include <bridge_settings.h>
+
 // TODO: rename to just bridge
 LOG_MODULE_DECLARE(zmk_bridge, CONFIG_ZMK_LOG_LEVEL);
 
@@ -57,3 +60,31 @@ bridge_Response get_device_info(const bridge_Request *req) {
 }
 
 BRIDGE_SUBSYSTEM_HANDLER(core, get_device_info);
+
+bridge_Response reset_settings(const bridge_Request *req) {
+    bridge_settings_reset();
+    return CORE_RESPONSE(reset_settings, true);
+}
+
+BRIDGE_SUBSYSTEM_HANDLER(core, reset_settings);
+
+#if IS_ENABLED(CONFIG_ZMK_BRIDGE_LATENCY_STATS)
+// Async, so the shared snapshot is only ever taken and encoded on the Bridge work queue.
+void get_latency_stats(const bridge_Request *req, struct bridge_completion *completion) {
+    bridge_core_LatencyStats resp = bridge_core_LatencyStats_init_zero;
+
+    resp.dropped = bridge_latency_snapshot();
+    resp.commands.funcs.encode = bridge_latency_encode_commands;
+
+    const bridge_Response response = CORE_RESPONSE(get_latency_stats, resp);
+    bridge_complete(completion, &response);
+}
+
+bridge_Response reset_latency_stats(const bridge_Request *req) {
+    bridge_latency_reset();
+    return CORE_RESPONSE(reset_latency_stats, true);
+}
+
+BRIDGE_SUBSYSTEM_HANDLER_ASYNC(core, get_latency_stats);
+BRIDGE_SUBSYSTEM_HANDLER(core, reset_latency_stats);
+#endif // IS_ENABLED(CONFIG_ZMK_BRIDGE_LATENCY_STATS)
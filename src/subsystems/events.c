@@ -0,0 +1,268 @@
+/*
+ * Copyright (c) 2025 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <zephyr/init.h>
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/sys/atomic.h>
+#include <zephyr/sys/util.h>
+#include <pb_encode.h>
+
+#include <zmk/bridge.h>
+#include <dt-bindings/zmk/hid_usage_pages.h>
+#include <zmk/event_manager.h>
+#include <zmk/events/keycode_state_changed.h>
+#include <zmk/events/layer_state_changed.h>
+#include <zmk/events/position_state_changed.h>
+
+LOG_MODULE_DECLARE(zmk_bridge, CONFIG_ZMK_BRIDGE_LOG_LEVEL);
+
+#define EVENTS_RESPONSE(type, ...) BRIDGE_RESPONSE(events, type, __VA_ARGS__)
+
+#define RING_SIZE CONFIG_ZMK_BRIDGE_EVENTS_RING_SIZE
+#define RING_MASK (RING_SIZE - 1)
+#define BATCH_SIZE CONFIG_ZMK_BRIDGE_EVENTS_BATCH_SIZE
+
+BUILD_ASSERT(IS_POWER_OF_TWO(RING_SIZE),
+             "CONFIG_ZMK_BRIDGE_EVENTS_RING_SIZE must be a power of two");
+// Fixed32 events plus the tags, lengths and varints around them, see bridge_notify().
+BUILD_ASSERT(BATCH_SIZE * 4 + 24 <= CONFIG_ZMK_BRIDGE_NOTIFICATION_MAX_SIZE,
+             "CONFIG_ZMK_BRIDGE_EVENTS_BATCH_SIZE does not fit in a notification");
+BUILD_ASSERT(ARRAY_SIZE(((bridge_events_Stats *)0)->dropped) == _bridge_events_EventType_ARRAYSIZE,
+             "events.options and EventType disagree");
+
+// Layout of the packed events, see events.EventBatch.
+#define EVENT_STATE BIT(3)
+#define EVENT_VALUE_SHIFT 4
+#define EVENT_DELTA_SHIFT 20
+#define EVENT_DELTA_MAX (BIT(32 - EVENT_DELTA_SHIFT) - 1)
+
+/*
+ * Bounded multi-producer ring, events are raised from whichever thread runs the event manager.
+ * Producers claim a position by moving ring_head forward and publish the slot by setting its
+ * sequence to position + 1. The flush work is the only consumer, it frees a slot by setting its
+ * sequence to position + RING_SIZE.
+ */
+struct event_slot {
+    atomic_t seq;
+    uint32_t time_ms;
+    uint32_t event;
+};
+
+static struct event_slot ring[RING_SIZE];
+static atomic_t ring_head;
+static atomic_t ring_tail;
+
+// Bit n is set while EventType n is streamed.
+static atomic_t events_filter;
+
+static atomic_t events_dropped[_bridge_events_EventType_ARRAYSIZE];
+// Dropped since the last batch, reported in it.
+static atomic_t events_dropped_pending;
+static atomic_t events_count;
+static atomic_t batches_count;
+static atomic_t batches_dropped;
+
+static void events_flush_work_handler(struct k_work *work);
+static K_WORK_DELAYABLE_DEFINE(events_flush_work, events_flush_work_handler);
+
+static void event_push(bridge_events_EventType type, uint16_t value, bool state) {
+    if (!atomic_test_bit(&events_filter, type)) {
+        return;
+    }
+
+    const uint32_t time_ms = k_uptime_get_32();
+    uint32_t pos = atomic_get(&ring_head);
+    struct event_slot *slot;
+
+    for (;;) {
+        slot = &ring[pos & RING_MASK];
+        const int32_t diff = (int32_t)((uint32_t)atomic_get(&slot->seq) - pos);
+
+        if (diff == 0) {
+            if (atomic_cas(&ring_head, pos, pos + 1)) {
+                break;
+            }
+            pos = atomic_get(&ring_head);
+        } else if (diff < 0) {
+            // The slot still holds an event from one lap ago, the ring is full.
+            atomic_inc(&events_dropped[type]);
+            atomic_inc(&events_dropped_pending);
+            return;
+        } else {
+            pos = atomic_get(&ring_head);
+        }
+    }
+
+    slot->time_ms = time_ms;
+    slot->event = type | (state ? EVENT_STATE : 0) | ((uint32_t)value << EVENT_VALUE_SHIFT);
+    atomic_set(&slot->seq, pos + 1);
+
+    // Only the first event of a batch and the one filling it touch the work item.
+    const uint32_t queued = pos - (uint32_t)atomic_get(&ring_tail);
+    if (queued == BATCH_SIZE - 1) {
+        k_work_reschedule(&events_flush_work, K_NO_WAIT);
+    } else if (queued == 0) {
+        k_work_schedule(&events_flush_work, K_MSEC(CONFIG_ZMK_BRIDGE_EVENTS_FLUSH_DEADLINE_MS));
+    }
+}
+
+// Takes the oldest published event, false when there is none.
+static bool event_pop(struct event_slot *out) {
+    const uint32_t pos = atomic_get(&ring_tail);
+    struct event_slot *slot = &ring[pos & RING_MASK];
+
+    if ((uint32_t)atomic_get(&slot->seq) != pos + 1) {
+        return false;
+    }
+
+    out->time_ms = slot->time_ms;
+    out->event = slot->event;
+    atomic_set(&slot->seq, pos + RING_SIZE);
+    atomic_set(&ring_tail, pos + 1);
+    return true;
+}
+
+struct event_batch {
+    uint32_t events[BATCH_SIZE];
+    size_t len;
+};
+
+static bool encode_batch_events(pb_ostream_t *stream, const pb_field_t *field, void *const *arg) {
+    const struct event_batch *batch = *arg;
+
+    if (batch->len == 0) {
+        return true;
+    }
+
+    if (!pb_encode_tag(stream, PB_WT_STRING, field->tag) ||
+        !pb_encode_varint(stream, batch->len * sizeof(uint32_t))) {
+        return false;
+    }
+
+    for (size_t i = 0; i < batch->len; i++) {
+        if (!pb_encode_fixed32(stream, &batch->events[i])) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+static void events_flush_work_handler(struct k_work *work) {
+    struct event_slot next;
+    bool have_next = event_pop(&next);
+
+    while (have_next) {
+        struct event_batch batch = {.len = 0};
+        const uint32_t base_time_ms = next.time_ms;
+
+        do {
+            const uint32_t delta = MIN(next.time_ms - base_time_ms, EVENT_DELTA_MAX);
+            batch.events[batch.len++] = next.event | (delta << EVENT_DELTA_SHIFT);
+            have_next = event_pop(&next);
+        } while (have_next && batch.len < BATCH_SIZE &&
+                 next.time_ms - base_time_ms <= EVENT_DELTA_MAX);
+
+        bridge_events_EventBatch resp = bridge_events_EventBatch_init_zero;
+        resp.base_time_ms = base_time_ms;
+        resp.events.funcs.encode = encode_batch_events;
+        resp.events.arg = &batch;
+        resp.dropped = atomic_clear(&events_dropped_pending);
+
+        atomic_add(&events_count, batch.len);
+        atomic_inc(&batches_count);
+
+        const bridge_Notification notification = BRIDGE_NOTIFICATION(events, batch, resp);
+        if (bridge_notify(&notification, BRIDGE_NOTIFICATION_PRIORITY_LOW) < 0) {
+            atomic_inc(&batches_dropped);
+        }
+    }
+
+    // An event claimed but not yet published when we looked saw the old tail and did not schedule.
+    if (atomic_get(&ring_head) != atomic_get(&ring_tail)) {
+        k_work_schedule(&events_flush_work, K_MSEC(CONFIG_ZMK_BRIDGE_EVENTS_FLUSH_DEADLINE_MS));
+    }
+}
+
+static int events_listener(const zmk_event_t *eh) {
+    const struct zmk_position_state_changed *position = as_zmk_position_state_changed(eh);
+    if (position) {
+        event_push(bridge_events_EventType_EVENT_TYPE_POSITION, position->position,
+                   position->state);
+        return ZMK_EV_EVENT_BUBBLE;
+    }
+
+    const struct zmk_layer_state_changed *layer = as_zmk_layer_state_changed(eh);
+    if (layer) {
+        event_push(bridge_events_EventType_EVENT_TYPE_LAYER, layer->layer, layer->state);
+        return ZMK_EV_EVENT_BUBBLE;
+    }
+
+    const struct zmk_keycode_state_changed *keycode = as_zmk_keycode_state_changed(eh);
+    if (keycode) {
+        if (keycode->usage_page == HID_USAGE_KEY) {
+            event_push(bridge_events_EventType_EVENT_TYPE_KEYBOARD, keycode->keycode,
+                       keycode->state);
+        } else if (keycode->usage_page == HID_USAGE_CONSUMER) {
+            event_push(bridge_events_EventType_EVENT_TYPE_CONSUMER, keycode->keycode,
+                       keycode->state);
+        }
+    }
+
+    return ZMK_EV_EVENT_BUBBLE;
+}
+
+ZMK_LISTENER(bridge_events, events_listener);
+ZMK_SUBSCRIPTION(bridge_events, zmk_position_state_changed);
+ZMK_SUBSCRIPTION(bridge_events, zmk_layer_state_changed);
+ZMK_SUBSCRIPTION(bridge_events, zmk_keycode_state_changed);
+
+bridge_Response subscribe(const bridge_Request *req) {
+    const uint32_t filter = req->subsystem.events.request_type.subscribe.filter;
+
+    atomic_set(&events_filter, filter & BIT_MASK(_bridge_events_EventType_ARRAYSIZE));
+    return EVENTS_RESPONSE(subscribe, true);
+}
+
+bridge_Response get_stats(const bridge_Request *req) {
+    bridge_events_Stats resp = bridge_events_Stats_init_zero;
+
+    resp.dropped_count = ARRAY_SIZE(resp.dropped);
+    for (size_t i = 0; i < ARRAY_SIZE(resp.dropped); i++) {
+        resp.dropped[i] = atomic_get(&events_dropped[i]);
+    }
+    resp.events = atomic_get(&events_count);
+    resp.batches = atomic_get(&batches_count);
+    resp.batches_dropped = atomic_get(&batches_dropped);
+
+    return EVENTS_RESPONSE(get_stats, resp);
+}
+
+bridge_Response reset_stats(const bridge_Request *req) {
+    for (size_t i = 0; i < ARRAY_SIZE(events_dropped); i++) {
+        atomic_clear(&events_dropped[i]);
+    }
+    atomic_clear(&events_dropped_pending);
+    atomic_clear(&events_count);
+    atomic_clear(&batches_count);
+    atomic_clear(&batches_dropped);
+
+    return EVENTS_RESPONSE(reset_stats, true);
+}
+
+BRIDGE_SUBSYSTEM_HANDLER(events, subscribe);
+BRIDGE_SUBSYSTEM_HANDLER(events, get_stats);
+BRIDGE_SUBSYSTEM_HANDLER(events, reset_stats);
+
+static int events_init(void) {
+    for (uint32_t i = 0; i < RING_SIZE; i++) {
+        atomic_set(&ring[i].seq, i);
+    }
+    return 0;
+}
+
+SYS_INIT(events_init, APPLICATION, CONFIG_APPLICATION_INIT_PRIORITY);
@@ -0,0 +1,219 @@
+/*
+ * Copyright (c) 2025 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <zephyr/logging/log.h>
+#include <zephyr/sys/util.h>
+#include <pb_decode.h>
+#include <pb_encode.h>
+
+#include <zmk/bridge.h>
+#include <zmk/behavior.h>
+#include <zmk/keymap.h>
+#include <zmk/matrix.h>
+
+LOG_MODULE_DECLARE(zmk_bridge, CONFIG_ZMK_BRIDGE_LOG_LEVEL);
+
+#define KEYMAP_RESPONSE(type, ...) BRIDGE_RESPONSE(keymap, type, __VA_ARGS__)
+
+#define MAX_BINDINGS CONFIG_ZMK_BRIDGE_KEYMAP_MAX_BINDINGS
+#define VALUES_PER_BINDING 3
+
+/*
+ * Values of write_bindings are decoded into this buffer, under the Bridge handler lock, right
+ * before the handler applies them.
+ */
+static uint32_t keymap_write_values[MAX_BINDINGS * VALUES_PER_BINDING];
+static size_t keymap_write_len;
+
+static zmk_behavior_local_id_t binding_local_id(const struct zmk_behavior_binding *binding) {
+#if IS_ENABLED(CONFIG_ZMK_BEHAVIOR_LOCAL_IDS_IN_BINDINGS)
+    return binding->local_id;
+#else
+    return zmk_behavior_get_local_id(binding->behavior_dev);
+#endif // IS_ENABLED(CONFIG_ZMK_BEHAVIOR_LOCAL_IDS_IN_BINDINGS)
+}
+
+static bool encode_binding_values_raw(pb_ostream_t *stream, zmk_keymap_layer_id_t layer_id,
+                                      uint32_t start, uint32_t count) {
+    for (uint32_t i = 0; i < count; i++) {
+        const struct zmk_behavior_binding *binding =
+            zmk_keymap_get_layer_binding_at_idx(layer_id, start + i);
+        if (!binding) {
+            return false;
+        }
+
+        if (!pb_encode_varint(stream, binding_local_id(binding)) ||
+            !pb_encode_varint(stream, binding->param1) ||
+            !pb_encode_varint(stream, binding->param2)) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/*
+ * Streams the bindings straight from the keymap as one packed field, the count is passed in arg.
+ * The encoder runs after the handler lock is released, so a write from another session can change
+ * the encoded size between nanopb's passes. The frame then fails to encode and the host retries.
+ */
+static bool encode_binding_values(pb_ostream_t *stream, const pb_field_t *field,
+                                  void *const *arg) {
+    const bridge_keymap_Bindings *bindings = field->message;
+    const uint32_t count = (uintptr_t)*arg;
+    const zmk_keymap_layer_id_t layer_id = zmk_keymap_layer_index_to_id(bindings->layer);
+
+    if (count == 0) {
+        return true;
+    }
+
+    pb_ostream_t sizing = PB_OSTREAM_SIZING;
+    if (!encode_binding_values_raw(&sizing, layer_id, bindings->start, count)) {
+        return false;
+    }
+
+    if (!pb_encode_tag(stream, PB_WT_STRING, field->tag) ||
+        !pb_encode_varint(stream, sizing.bytes_written)) {
+        return false;
+    }
+
+    const size_t begin = stream->bytes_written;
+    return encode_binding_values_raw(stream, layer_id, bindings->start, count) &&
+           stream->bytes_written - begin == sizing.bytes_written;
+}
+
+static bool decode_binding_value(pb_istream_t *stream, const pb_field_t *field, void **arg) {
+    uint32_t value;
+    if (!pb_decode_varint32(stream, &value)) {
+        return false;
+    }
+
+    if (keymap_write_len >= ARRAY_SIZE(keymap_write_values)) {
+        LOG_WRN("Writing more than %d bindings", MAX_BINDINGS);
+        return false;
+    }
+
+    keymap_write_values[keymap_write_len++] = value;
+    return true;
+}
+
+bridge_Response get_info(const bridge_Request *req) {
+    bridge_keymap_KeymapInfo resp = bridge_keymap_KeymapInfo_init_zero;
+
+    resp.layers = ZMK_KEYMAP_LAYERS_LEN;
+    resp.positions = ZMK_KEYMAP_LEN;
+    resp.max_bindings = MAX_BINDINGS;
+
+    return KEYMAP_RESPONSE(get_info, resp);
+}
+
+bridge_Response read_bindings(const bridge_Request *req) {
+    const bridge_keymap_BindingRange *range = &req->subsystem.keymap.request_type.read_bindings;
+
+    if (range->layer >= ZMK_KEYMAP_LAYERS_LEN || range->start >= ZMK_KEYMAP_LEN) {
+        LOG_WRN("Keymap range %d:%d is out of range", range->layer, range->start);
+        return BRIDGE_RESPONSE_SIMPLE(false);
+    }
+
+    uint32_t count = ZMK_KEYMAP_LEN - range->start;
+    if (range->count > 0) {
+        count = MIN(count, range->count);
+    }
+    count = MIN(count, MAX_BINDINGS);
+
+    bridge_keymap_Bindings resp = bridge_keymap_Bindings_init_zero;
+    resp.layer = range->layer;
+    resp.start = range->start;
+    resp.values.funcs.encode = encode_binding_values;
+    resp.values.arg = (void *)(uintptr_t)count;
+
+    return KEYMAP_RESPONSE(read_bindings, resp);
+}
+
+bridge_Response write_bindings(const bridge_Request *req) {
+    const bridge_keymap_Bindings *bindings = &req->subsystem.keymap.request_type.write_bindings;
+
+    // Taken right away, so a write whose values were not decoded cannot replay old ones.
+    const size_t len = keymap_write_len;
+    keymap_write_len = 0;
+
+    const size_t count = len / VALUES_PER_BINDING;
+    if (len == 0 || len % VALUES_PER_BINDING != 0) {
+        LOG_WRN("Bindings need %d values each, got %zu", VALUES_PER_BINDING, len);
+        return BRIDGE_RESPONSE_SIMPLE(false);
+    }
+
+    if (bindings->layer >= ZMK_KEYMAP_LAYERS_LEN || bindings->start >= ZMK_KEYMAP_LEN ||
+        count > ZMK_KEYMAP_LEN - bindings->start) {
+        LOG_WRN("Keymap range %d:%d+%zu is out of range", bindings->layer, bindings->start,
+                count);
+        return BRIDGE_RESPONSE_SIMPLE(false);
+    }
+
+    // Every behavior is checked first, so a bad binding leaves the keymap untouched.
+    for (size_t i = 0; i < count; i++) {
+        const uint32_t id = keymap_write_values[i * VALUES_PER_BINDING];
+        if (id > UINT16_MAX || !zmk_behavior_find_behavior_name_from_local_id(id)) {
+            LOG_WRN("No behavior with local id %d", id);
+            return BRIDGE_RESPONSE_SIMPLE(false);
+        }
+    }
+
+    const zmk_keymap_layer_id_t layer_id = zmk_keymap_layer_index_to_id(bindings->layer);
+    uint32_t written = 0;
+
+    for (size_t i = 0; i < count; i++) {
+        const uint32_t *values = &keymap_write_values[i * VALUES_PER_BINDING];
+        struct zmk_behavior_binding binding = {
+            .behavior_dev = zmk_behavior_find_behavior_name_from_local_id(values[0]),
+            .param1 = values[1],
+            .param2 = values[2],
+        };
+#if IS_ENABLED(CONFIG_ZMK_BEHAVIOR_LOCAL_IDS_IN_BINDINGS)
+        binding.local_id = values[0];
+#endif // IS_ENABLED(CONFIG_ZMK_BEHAVIOR_LOCAL_IDS_IN_BINDINGS)
+
+        const uint32_t position = bindings->start + i;
+        int err = zmk_keymap_set_layer_binding_at_idx(layer_id, position, binding);
+        if (err < 0) {
+            LOG_ERR("Failed to set binding %d:%d %d", bindings->layer, position, err);
+            break;
+        }
+        written++;
+    }
+
+    bridge_Response resp = KEYMAP_RESPONSE(write_bindings, written);
+    resp.request_status = written == count;
+    return resp;
+}
+
+static bool decode_request_type(pb_istream_t *stream, const pb_field_t *field, void **arg) {
+    const bool batched = (uintptr_t)*arg;
+
+    if (field->tag == bridge_keymap_Request_write_bindings_tag) {
+        bridge_keymap_Bindings *bindings = field->pData;
+        bindings->values.funcs.decode = batched ? bridge_decode_batch_reject : decode_binding_value;
+        if (!batched) {
+            keymap_write_len = 0;
+        }
+    }
+
+    return true;
+}
+
+static bool keymap_prepare_decode(pb_istream_t *stream, const pb_field_t *field, bool batched) {
+    bridge_keymap_Request *keymap_req = field->pData;
+    keymap_req->cb_request_type.funcs.decode = decode_request_type;
+    keymap_req->cb_request_type.arg = (void *)(uintptr_t)batched;
+    return true;
+}
+
+static void keymap_discard_decode(const bridge_Request *req) { keymap_write_len = 0; }
+
+BRIDGE_SUBSYSTEM_DECODER(keymap, keymap_prepare_decode, keymap_discard_decode);
+BRIDGE_SUBSYSTEM_HANDLER(keymap, get_info);
+BRIDGE_SUBSYSTEM_HANDLER(keymap, read_bindings);
+BRIDGE_SUBSYSTEM_HANDLER(keymap, write_bindings);
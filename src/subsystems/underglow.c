@@ -7,10 +7,15 @@
 #include <zephyr/logging/log.h>
 #include <zephyr/device.h>
 #include <zephyr/devicetree.h>
+#include <zephyr/init.h>
+#include <zephyr/drivers/led_strip.h>
 #include <zephyr/logging/log.h>
 #include <zephyr/sys/util.h>
+#include <pb_decode.h>
 #include <pb_encode.h>
 
+#include <bridge_settings.h>
+#include <led_color.h>
 #include <zmk/bridge.h>
 #include <dt-bindings/zmk/rgb.h>
 #include <zmk/rgb_underglow.h>
@@ -27,45 +32,134 @@ BRIDGE_DECLARE_BINDING(binding, event, rgb_ug);
 #define RGB_MAX 255
 
 static struct zmk_led_hsb color_state = {.h = 0, .s = 0, .b = BRT_MAX};
+static struct k_spinlock color_state_lock;
 
-static void invoke_hsb_cmd(const struct zmk_led_hsb state) {
-    binding.param1 = RGB_COLOR_HSB_CMD;
-    binding.param2 = RGB_COLOR_HSB_VAL(state.h, state.s, state.b);
-    bridge_tap_binding(&binding, event);
+/*
+ * Behavior commands are applied from a dedicated work queue, so the 2 ms tap in
+ * bridge_tap_binding does not stall a Bridge worker. RGB_COLOR_HSB_CMD entries carry no value,
+ * the work handler applies whatever color_state holds at that point. Consecutive color updates
+ * therefore collapse into a single queue entry, while other commands keep their order.
+ */
+K_MSGQ_DEFINE(underglow_cmd_queue, sizeof(uint32_t), CONFIG_ZMK_BRIDGE_UNDERGLOW_CMD_QUEUE_SIZE,
+              4);
+K_THREAD_STACK_DEFINE(underglow_work_q_stack, CONFIG_ZMK_BRIDGE_UNDERGLOW_WORK_Q_STACK_SIZE);
+static struct k_work_q underglow_work_q;
+
+// The newest entry of underglow_cmd_queue is an RGB_COLOR_HSB_CMD that has not been taken yet.
+static bool hsb_cmd_queued;
+
+static void underglow_work_handler(struct k_work *work) {
+    uint32_t cmd;
+    while (k_msgq_get(&underglow_cmd_queue, &cmd, K_NO_WAIT) == 0) {
+        binding.param1 = cmd;
+        binding.param2 = 0;
+
+        if (cmd == RGB_COLOR_HSB_CMD) {
+            k_spinlock_key_t key = k_spin_lock(&color_state_lock);
+            const struct zmk_led_hsb state = color_state;
+            if (k_msgq_num_used_get(&underglow_cmd_queue) == 0) {
+                hsb_cmd_queued = false;
+            }
+            k_spin_unlock(&color_state_lock, key);
+
+            binding.param2 = RGB_COLOR_HSB_VAL(state.h, state.s, state.b);
+        }
+
+        bridge_tap_binding(&binding, event);
+    }
 }
 
-static uint32_t c_clamp(uint32_t value, uint32_t min_val, uint32_t max_val) {
-    if (value < min_val) {
-        return min_val;
-    } else if (value > max_val) {
-        return max_val;
-    } else {
-        return value;
+static K_WORK_DEFINE(underglow_work, underglow_work_handler);
+
+static bool queue_ug_cmd(uint32_t cmd) {
+    k_spinlock_key_t key = k_spin_lock(&color_state_lock);
+    int err = k_msgq_put(&underglow_cmd_queue, &cmd, K_NO_WAIT);
+    if (err == 0) {
+        hsb_cmd_queued = false;
     }
+    k_spin_unlock(&color_state_lock, key);
+
+    if (err < 0) {
+        LOG_WRN("Underglow command queue is full");
+        return false;
+    }
+
+    k_work_submit_to_queue(&underglow_work_q, &underglow_work);
+    return true;
 }
 
-static struct zmk_led_hsb rgb_to_hsb(uint32_t r, uint32_t g, uint32_t b) {
-    struct zmk_led_hsb hsb_color;
+// Bridge handlers and the animation tick publish new colors here.
+static bool update_color_state(const struct zmk_led_hsb state) {
+    int err = 0;
+
+    k_spinlock_key_t key = k_spin_lock(&color_state_lock);
+    color_state = state;
+    if (!hsb_cmd_queued) {
+        const uint32_t cmd = RGB_COLOR_HSB_CMD;
+        err = k_msgq_put(&underglow_cmd_queue, &cmd, K_NO_WAIT);
+        hsb_cmd_queued = (err == 0);
+    }
+    k_spin_unlock(&color_state_lock, key);
+
+    if (err < 0) {
+        LOG_WRN("Underglow command queue is full");
+        return false;
+    }
 
-    float r_n = (float)r / 255;
-    float g_n = (float)g / 255;
-    float b_n = (float)b / 255;
+    k_work_submit_to_queue(&underglow_work_q, &underglow_work);
+    return true;
+}
 
-    float c_max = MAX(r_n, MAX(g_n, b_n));
-    float delta = c_max - MIN(r_n, MIN(g_n, b_n));
+static void load_color_state(const void *value);
 
-    if (c_max == r_n) {
-        hsb_color.h = (uint32_t)((60 * (g_n - b_n) / delta) + 360) % 360;
-    } else if (c_max == g_n) {
-        hsb_color.h = (uint32_t)((60 * (b_n - r_n) / delta) + 120) % 360;
-    } else if (c_max == b_n) {
-        hsb_color.h = (uint32_t)((60 * (r_n - g_n) / delta) + 240) % 360;
+BRIDGE_SETTING_DEFINE(color_setting, "underglow/color", struct zmk_led_hsb, load_color_state,
+                      {.h = 0, .s = 0, .b = BRT_MAX});
+
+/*
+ * Settings may be loaded before underglow_work_q is started, in which case the color is only
+ * stored and underglow_work_q_init() applies it.
+ */
+static bool underglow_work_q_started;
+static bool color_state_loaded;
+
+static void load_color_state(const void *value) {
+    struct zmk_led_hsb state;
+    memcpy(&state, value, sizeof(state));
+
+    k_spinlock_key_t key = k_spin_lock(&color_state_lock);
+    const bool started = underglow_work_q_started;
+    if (!started) {
+        color_state = state;
+        color_state_loaded = true;
+    }
+    k_spin_unlock(&color_state_lock, key);
+
+    if (started) {
+        update_color_state(state);
     }
+}
+
+// A color picked by the host, kept across reboots unlike animation frames.
+static bool set_color_state(const struct zmk_led_hsb state) {
+    bridge_settings_set(&color_setting, &state);
+    return update_color_state(state);
+}
 
-    hsb_color.s = c_max == 0 ? 0 : (delta / c_max) * 100;
-    hsb_color.b = c_max * 100;
+static struct zmk_led_hsb get_color_state(void) {
+    k_spinlock_key_t key = k_spin_lock(&color_state_lock);
+    const struct zmk_led_hsb state = color_state;
+    k_spin_unlock(&color_state_lock, key);
+    return state;
+}
 
-    return hsb_color;
+static uint32_t c_clamp(uint32_t value, uint32_t min_val, uint32_t max_val) {
+    if (value < min_val) {
+        return min_val;
+    } else if (value > max_val) {
+        return max_val;
+    } else {
+        return value;
+    }
 }
 
 bridge_Response reset(const bridge_Request *req) {
@@ -74,12 +168,10 @@ bridge_Response reset(const bridge_Request *req) {
         return BRIDGE_RESPONSE_SIMPLE(false);
     }
     // White.
-    color_state.h = 0;
-    color_state.s = 0;
-    color_state.b = BRT_MAX;
-    invoke_hsb_cmd(color_state);
+    const struct zmk_led_hsb white = {.h = 0, .s = 0, .b = BRT_MAX};
+    bool status = set_color_state(white);
 
-    return BRIDGE_RESPONSE_SIMPLE(true);
+    return BRIDGE_RESPONSE_SIMPLE(status);
 }
 
 bridge_Response set_ug_cmd(const bridge_Request *req) {
@@ -88,11 +180,9 @@ bridge_Response set_ug_cmd(const bridge_Request *req) {
         return BRIDGE_RESPONSE_SIMPLE(false);
     }
 
-    binding.param1 = req->subsystem.underglow.request_type.set_ug_cmd;
-    binding.param2 = 0;
-    bridge_tap_binding(&binding, event);
+    bool status = queue_ug_cmd(req->subsystem.underglow.request_type.set_ug_cmd);
 
-    return BRIDGE_RESPONSE_SIMPLE(true);
+    return BRIDGE_RESPONSE_SIMPLE(status);
 }
 
 bridge_Response set_hsb(const bridge_Request *req) {
@@ -102,12 +192,14 @@ bridge_Response set_hsb(const bridge_Request *req) {
     }
 
     bridge_underglow_Color_HSB color_hsb = req->subsystem.underglow.request_type.set_hsb;
-    color_state.h = c_clamp(color_hsb.h, 0, HUE_MAX);
-    color_state.s = c_clamp(color_hsb.s, 0, SAT_MAX);
-    color_state.b = c_clamp(color_hsb.b, 0, BRT_MAX);
-    invoke_hsb_cmd(color_state);
-
-    return BRIDGE_RESPONSE_SIMPLE(true);
+    const struct zmk_led_hsb state = {
+        .h = c_clamp(color_hsb.h, 0, HUE_MAX),
+        .s = c_clamp(color_hsb.s, 0, SAT_MAX),
+        .b = c_clamp(color_hsb.b, 0, BRT_MAX),
+    };
+    bool status = set_color_state(state);
+
+    return BRIDGE_RESPONSE_SIMPLE(status);
 }
 
 bridge_Response set_rgb(const bridge_Request *req) {
@@ -117,11 +209,14 @@ bridge_Response set_rgb(const bridge_Request *req) {
     }
 
     bridge_underglow_Color_RGB color_rgb = req->subsystem.underglow.request_type.set_rgb;
-    color_state = rgb_to_hsb(c_clamp(color_rgb.r, 0, RGB_MAX), c_clamp(color_rgb.g, 0, RGB_MAX),
-                             c_clamp(color_rgb.b, 0, RGB_MAX));
-    invoke_hsb_cmd(color_state);
-
-    return BRIDGE_RESPONSE_SIMPLE(true);
+    const struct led_rgb rgb = {
+        .r = c_clamp(color_rgb.r, 0, RGB_MAX),
+        .g = c_clamp(color_rgb.g, 0, RGB_MAX),
+        .b = c_clamp(color_rgb.b, 0, RGB_MAX),
+    };
+    bool status = set_color_state(led_color_rgb_to_hsb(rgb));
+
+    return BRIDGE_RESPONSE_SIMPLE(status);
 }
 
 bridge_Response set_brightness(const bridge_Request *req) {
@@ -130,10 +225,11 @@ bridge_Response set_brightness(const bridge_Request *req) {
         return BRIDGE_RESPONSE_SIMPLE(false);
     }
 
-    color_state.b = c_clamp(req->subsystem.underglow.request_type.set_brightness, 0, BRT_MAX);
-    invoke_hsb_cmd(color_state);
+    struct zmk_led_hsb state = get_color_state();
+    state.b = c_clamp(req->subsystem.underglow.request_type.set_brightness, 0, BRT_MAX);
+    bool status = set_color_state(state);
 
-    return BRIDGE_RESPONSE_SIMPLE(true);
+    return BRIDGE_RESPONSE_SIMPLE(status);
 }
 
 bridge_Response set_saturation(const bridge_Request *req) {
@@ -142,10 +238,11 @@ bridge_Response set_saturation(const bridge_Request *req) {
         return BRIDGE_RESPONSE_SIMPLE(false);
     }
 
-    color_state.s = c_clamp(req->subsystem.underglow.request_type.set_saturation, 0, SAT_MAX);
-    invoke_hsb_cmd(color_state);
+    struct zmk_led_hsb state = get_color_state();
+    state.s = c_clamp(req->subsystem.underglow.request_type.set_saturation, 0, SAT_MAX);
+    bool status = set_color_state(state);
 
-    return BRIDGE_RESPONSE_SIMPLE(true);
+    return BRIDGE_RESPONSE_SIMPLE(status);
 }
 
 bridge_Response set_hue(const bridge_Request *req) {
@@ -154,12 +251,424 @@ bridge_Response set_hue(const bridge_Request *req) {
         return BRIDGE_RESPONSE_SIMPLE(false);
     }
 
-    color_state.h = c_clamp(req->subsystem.underglow.request_type.set_hue, 0, HUE_MAX);
-    invoke_hsb_cmd(color_state);
+    struct zmk_led_hsb state = get_color_state();
+    state.h = c_clamp(req->subsystem.underglow.request_type.set_hue, 0, HUE_MAX);
+    bool status = set_color_state(state);
+
+    return BRIDGE_RESPONSE_SIMPLE(status);
+}
+
+#if IS_ENABLED(CONFIG_ZMK_BRIDGE_UNDERGLOW_PIXELS)
+
+#define STRIP_CHOSEN DT_CHOSEN(zmk_underglow)
+#define STRIP_NUM_PIXELS DT_PROP(STRIP_CHOSEN, chain_length)
+
+static const struct device *const led_strip = DEVICE_DT_GET(STRIP_CHOSEN);
+
+/*
+ * Pixel data is decoded into pixels_staged, as the offset it goes to is only known once the whole
+ * request was decoded. The handler then copies it into the back buffer, both under the Bridge
+ * handler lock. pixels_front_mutex keeps the work queue from reading the front buffer while a
+ * commit swaps it.
+ */
+static struct led_rgb pixels_staged[STRIP_NUM_PIXELS];
+static size_t pixels_staged_len;
+// The data was longer than the strip or ended in a partial pixel.
+static bool pixels_staged_invalid;
+static struct led_rgb pixel_buffers[2][STRIP_NUM_PIXELS];
+static struct led_rgb *pixels_back = pixel_buffers[0];
+static struct led_rgb *pixels_front = pixel_buffers[1];
+static K_MUTEX_DEFINE(pixels_front_mutex);
+
+#define PIXELS_LUT_NEEDED                                                                          \
+    (IS_ENABLED(CONFIG_ZMK_BRIDGE_UNDERGLOW_PIXELS_GAMMA) ||                                       \
+     CONFIG_ZMK_BRIDGE_UNDERGLOW_PIXELS_BRIGHTNESS < 255)
+
+#if PIXELS_LUT_NEEDED
+// Gamma and brightness of streamed pixels, applied once as they are decoded.
+static uint8_t pixels_lut[256];
+#endif // PIXELS_LUT_NEEDED
+
+static bool decode_pixel_data(pb_istream_t *stream, const pb_field_t *field, void **arg) {
+    const size_t count = stream->bytes_left / 3;
+    struct led_rgb *dst = pixels_staged;
+
+    pixels_staged_len = 0;
+    pixels_staged_invalid = stream->bytes_left % 3 != 0 || count > STRIP_NUM_PIXELS;
+    if (pixels_staged_invalid) {
+        LOG_WRN("Pixel data of %zu bytes does not fit the strip", stream->bytes_left);
+        return pb_read(stream, NULL, stream->bytes_left);
+    }
+
+    if (sizeof(struct led_rgb) == 3) {
+        if (!pb_read(stream, (uint8_t *)dst, count * 3)) {
+            return false;
+        }
+    } else {
+        for (size_t i = 0; i < count; i++) {
+            uint8_t rgb[3];
+            if (!pb_read(stream, rgb, sizeof(rgb))) {
+                return false;
+            }
+
+            dst[i].r = rgb[0];
+            dst[i].g = rgb[1];
+            dst[i].b = rgb[2];
+        }
+    }
+
+#if PIXELS_LUT_NEEDED
+    led_color_lut_apply(pixels_lut, dst, count);
+#endif // PIXELS_LUT_NEEDED
+
+    pixels_staged_len = count;
+    return true;
+}
+
+static void pixels_staged_reset(void) {
+    pixels_staged_len = 0;
+    pixels_staged_invalid = false;
+}
+
+static void pixels_work_handler(struct k_work *work) {
+    k_mutex_lock(&pixels_front_mutex, K_FOREVER);
+    int err = led_strip_update_rgb(led_strip, pixels_front, STRIP_NUM_PIXELS);
+    k_mutex_unlock(&pixels_front_mutex);
+
+    if (err < 0) {
+        LOG_ERR("Failed to update the LED strip %d", err);
+    }
+}
+
+static K_WORK_DEFINE(pixels_work, pixels_work_handler);
+
+bridge_Response set_pixels(const bridge_Request *req) {
+    const bridge_underglow_Pixels *pixels = &req->subsystem.underglow.request_type.set_pixels;
+    const size_t len = pixels_staged_len;
+    const bool invalid = pixels_staged_invalid;
+
+    // Taken right away, so a request whose data was not decoded cannot replay old pixels.
+    pixels_staged_reset();
+
+    if (invalid || pixels->offset > STRIP_NUM_PIXELS - len) {
+        LOG_WRN("Pixels from offset %u are out of range", pixels->offset);
+        return BRIDGE_RESPONSE_SIMPLE(false);
+    }
+
+    if (pixels->commit && !device_is_ready(led_strip)) {
+        LOG_ERR("The underglow LED strip is not ready!");
+        return BRIDGE_RESPONSE_SIMPLE(false);
+    }
+
+    memcpy(&pixels_back[pixels->offset], pixels_staged, len * sizeof(pixels_staged[0]));
+
+    if (pixels->commit) {
+        k_mutex_lock(&pixels_front_mutex, K_FOREVER);
+        struct led_rgb *shown = pixels_back;
+        pixels_back = pixels_front;
+        pixels_front = shown;
+        // Later partial updates build on the frame that is now shown.
+        memcpy(pixels_back, pixels_front, sizeof(pixel_buffers[0]));
+        k_mutex_unlock(&pixels_front_mutex);
+
+        k_work_submit_to_queue(&underglow_work_q, &pixels_work);
+    }
+
+    return BRIDGE_RESPONSE_SIMPLE(true);
+}
+
+BRIDGE_SUBSYSTEM_HANDLER(underglow, set_pixels);
+
+#endif // IS_ENABLED(CONFIG_ZMK_BRIDGE_UNDERGLOW_PIXELS)
+
+#if IS_ENABLED(CONFIG_ZMK_BRIDGE_UNDERGLOW_ANIMATION)
+
+#define KEYFRAME_MAX_DURATION_MS (10 * 60 * MSEC_PER_SEC)
+
+struct animation_keyframe {
+    struct zmk_led_hsb color;
+    uint32_t duration_ms;
+    bridge_underglow_Easing easing;
+};
+
+enum animation_state {
+    ANIMATION_STOPPED,
+    ANIMATION_PLAYING,
+    ANIMATION_PAUSED,
+};
+
+struct animation {
+    struct animation_keyframe keyframes[CONFIG_ZMK_BRIDGE_UNDERGLOW_ANIMATION_MAX_KEYFRAMES];
+    size_t len;
+    uint32_t loop_count;
+    // Sum of the keyframe durations, never 0 once an animation is uploaded.
+    uint32_t cycle_ms;
+    enum animation_state state;
+    // Uptime the animation would have started at to be where it is now, while playing.
+    uint32_t started_ms;
+    // Time into the animation, while paused or stopped.
+    uint32_t position_ms;
+};
+
+/*
+ * Keyframes are decoded into animation_upload, under the Bridge handler lock, and only copied to
+ * the animation the work queue plays once the whole upload was valid.
+ */
+static struct animation_keyframe
+    animation_upload[CONFIG_ZMK_BRIDGE_UNDERGLOW_ANIMATION_MAX_KEYFRAMES];
+static size_t animation_upload_len;
+
+static struct animation animation;
+static K_MUTEX_DEFINE(animation_mutex);
+// Last color the animation published, so held colors do not tap the binding on every frame.
+static struct zmk_led_hsb animation_shown;
+static bool animation_shown_valid;
+
+static bool decode_keyframe(pb_istream_t *stream, const pb_field_t *field, void **arg) {
+    bridge_underglow_Keyframe keyframe = bridge_underglow_Keyframe_init_zero;
+    if (!pb_decode(stream, bridge_underglow_Keyframe_fields, &keyframe)) {
+        return false;
+    }
+
+    if (animation_upload_len >= ARRAY_SIZE(animation_upload)) {
+        LOG_WRN("Animation has more than %d keyframes", ARRAY_SIZE(animation_upload));
+        return false;
+    }
+
+    animation_upload[animation_upload_len++] = (struct animation_keyframe){
+        .color =
+            {
+                .h = c_clamp(keyframe.color.h, 0, HUE_MAX),
+                .s = c_clamp(keyframe.color.s, 0, SAT_MAX),
+                .b = c_clamp(keyframe.color.b, 0, BRT_MAX),
+            },
+        .duration_ms = MIN(keyframe.duration_ms, KEYFRAME_MAX_DURATION_MS),
+        .easing = keyframe.easing,
+    };
+    return true;
+}
+
+// Eased progress through a keyframe, both in 1/65536.
+static uint32_t animation_ease(bridge_underglow_Easing easing, uint32_t t) {
+    switch (easing) {
+    case bridge_underglow_Easing_EASING_STEP:
+        return 0;
+    case bridge_underglow_Easing_EASING_EASE_IN_OUT: {
+        // t^2 * (3 - 2t)
+        const uint64_t t2 = (uint64_t)t * t;
+        return (t2 * (3 * (1 << 16) - 2 * t)) >> 32;
+    }
+    default:
+        return t;
+    }
+}
+
+static struct zmk_led_hsb animation_color_at(uint32_t t) {
+    for (size_t i = 0; i < animation.len; i++) {
+        const struct animation_keyframe *to = &animation.keyframes[i];
+        if (t < to->duration_ms) {
+            const struct animation_keyframe *from =
+                &animation.keyframes[i == 0 ? animation.len - 1 : i - 1];
+            const uint32_t progress = ((uint64_t)t << 16) / to->duration_ms;
+            return led_color_hsb_lerp(from->color, to->color, animation_ease(to->easing, progress));
+        }
+        t -= to->duration_ms;
+    }
+
+    return animation.keyframes[animation.len - 1].color;
+}
+
+static void animation_work_handler(struct k_work *work);
+static K_WORK_DELAYABLE_DEFINE(animation_work, animation_work_handler);
+
+static void animation_work_handler(struct k_work *work) {
+    k_mutex_lock(&animation_mutex, K_FOREVER);
+    if (animation.state != ANIMATION_PLAYING) {
+        k_mutex_unlock(&animation_mutex);
+        return;
+    }
+
+    const uint32_t elapsed = k_uptime_get_32() - animation.started_ms;
+    const bool done =
+        animation.loop_count > 0 && elapsed / animation.cycle_ms >= animation.loop_count;
+
+    struct zmk_led_hsb color;
+    if (done) {
+        color = animation.keyframes[animation.len - 1].color;
+        animation.state = ANIMATION_STOPPED;
+        animation.position_ms = 0;
+    } else {
+        color = animation_color_at(elapsed % animation.cycle_ms);
+        k_work_reschedule_for_queue(&underglow_work_q, &animation_work,
+                                    K_MSEC(CONFIG_ZMK_BRIDGE_UNDERGLOW_ANIMATION_FRAME_MS));
+    }
+
+    if (!animation_shown_valid || memcmp(&color, &animation_shown, sizeof(color)) != 0) {
+        animation_shown = color;
+        animation_shown_valid = true;
+        update_color_state(color);
+    }
+    k_mutex_unlock(&animation_mutex);
+}
+
+// Called with animation_mutex held.
+static void animation_halt(enum animation_state state) {
+    if (animation.state == ANIMATION_PLAYING) {
+        animation.position_ms = k_uptime_get_32() - animation.started_ms;
+    }
+    if (state == ANIMATION_STOPPED) {
+        animation.position_ms = 0;
+    }
+    animation.state = state;
+    k_work_cancel_delayable(&animation_work);
+}
+
+bridge_Response upload_animation(const bridge_Request *req) {
+    if (!device_is_ready(rgb_ug_dev)) {
+        LOG_ERR("The rgb_ug node cannot be found!");
+        return BRIDGE_RESPONSE_SIMPLE(false);
+    }
+
+    // Taken right away, so an upload whose keyframes were not decoded cannot replay old ones.
+    const size_t len = animation_upload_len;
+    animation_upload_len = 0;
+
+    uint32_t cycle_ms = 0;
+    for (size_t i = 0; i < len; i++) {
+        cycle_ms += animation_upload[i].duration_ms;
+    }
+
+    if (cycle_ms == 0) {
+        LOG_WRN("Animation has no keyframes or takes no time");
+        return BRIDGE_RESPONSE_SIMPLE(false);
+    }
+
+    k_mutex_lock(&animation_mutex, K_FOREVER);
+    animation_halt(ANIMATION_STOPPED);
+    memcpy(animation.keyframes, animation_upload, len * sizeof(animation_upload[0]));
+    animation.len = len;
+    animation.loop_count = req->subsystem.underglow.request_type.upload_animation.loop_count;
+    animation.cycle_ms = cycle_ms;
+    k_mutex_unlock(&animation_mutex);
 
     return BRIDGE_RESPONSE_SIMPLE(true);
 }
 
+bridge_Response control_animation(const bridge_Request *req) {
+    if (!device_is_ready(rgb_ug_dev)) {
+        LOG_ERR("The rgb_ug node cannot be found!");
+        return BRIDGE_RESPONSE_SIMPLE(false);
+    }
+
+    bool status = true;
+
+    k_mutex_lock(&animation_mutex, K_FOREVER);
+    switch (req->subsystem.underglow.request_type.control_animation) {
+    case bridge_underglow_AnimationControl_ANIMATION_PLAY:
+        if (animation.len == 0) {
+            LOG_WRN("No animation was uploaded");
+            status = false;
+        } else if (animation.state != ANIMATION_PLAYING) {
+            animation.started_ms = k_uptime_get_32() - animation.position_ms;
+            animation.state = ANIMATION_PLAYING;
+            animation_shown_valid = false;
+            k_work_reschedule_for_queue(&underglow_work_q, &animation_work, K_NO_WAIT);
+        }
+        break;
+    case bridge_underglow_AnimationControl_ANIMATION_PAUSE:
+        animation_halt(ANIMATION_PAUSED);
+        break;
+    case bridge_underglow_AnimationControl_ANIMATION_STOP:
+        animation_halt(ANIMATION_STOPPED);
+        break;
+    default:
+        status = false;
+        break;
+    }
+    k_mutex_unlock(&animation_mutex);
+
+    return BRIDGE_RESPONSE_SIMPLE(status);
+}
+
+BRIDGE_SUBSYSTEM_HANDLER(underglow, upload_animation);
+BRIDGE_SUBSYSTEM_HANDLER(underglow, control_animation);
+
+#endif // IS_ENABLED(CONFIG_ZMK_BRIDGE_UNDERGLOW_ANIMATION)
+
+#if IS_ENABLED(CONFIG_ZMK_BRIDGE_UNDERGLOW_PIXELS) ||                                              \
+    IS_ENABLED(CONFIG_ZMK_BRIDGE_UNDERGLOW_ANIMATION)
+
+static bool decode_request_type(pb_istream_t *stream, const pb_field_t *field, void **arg) {
+    const bool batched = (uintptr_t)*arg;
+
+#if IS_ENABLED(CONFIG_ZMK_BRIDGE_UNDERGLOW_PIXELS)
+    if (field->tag == bridge_underglow_Request_set_pixels_tag) {
+        bridge_underglow_Pixels *pixels = field->pData;
+        pixels->data.funcs.decode = batched ? bridge_decode_batch_reject : decode_pixel_data;
+        if (!batched) {
+            pixels_staged_reset();
+        }
+    }
+#endif // IS_ENABLED(CONFIG_ZMK_BRIDGE_UNDERGLOW_PIXELS)
+
+#if IS_ENABLED(CONFIG_ZMK_BRIDGE_UNDERGLOW_ANIMATION)
+    if (field->tag == bridge_underglow_Request_upload_animation_tag) {
+        bridge_underglow_Animation *upload = field->pData;
+        upload->keyframes.funcs.decode = batched ? bridge_decode_batch_reject : decode_keyframe;
+        if (!batched) {
+            animation_upload_len = 0;
+        }
+    }
+#endif // IS_ENABLED(CONFIG_ZMK_BRIDGE_UNDERGLOW_ANIMATION)
+
+    return true;
+}
+
+static bool underglow_prepare_decode(pb_istream_t *stream, const pb_field_t *field, bool batched) {
+    bridge_underglow_Request *ug_req = field->pData;
+    ug_req->cb_request_type.funcs.decode = decode_request_type;
+    ug_req->cb_request_type.arg = (void *)(uintptr_t)batched;
+    return true;
+}
+
+static void underglow_discard_decode(const bridge_Request *req) {
+#if IS_ENABLED(CONFIG_ZMK_BRIDGE_UNDERGLOW_PIXELS)
+    pixels_staged_reset();
+#endif // IS_ENABLED(CONFIG_ZMK_BRIDGE_UNDERGLOW_PIXELS)
+
+#if IS_ENABLED(CONFIG_ZMK_BRIDGE_UNDERGLOW_ANIMATION)
+    animation_upload_len = 0;
+#endif // IS_ENABLED(CONFIG_ZMK_BRIDGE_UNDERGLOW_ANIMATION)
+}
+
+BRIDGE_SUBSYSTEM_DECODER(underglow, underglow_prepare_decode, underglow_discard_decode);
+
+#endif // IS_ENABLED(CONFIG_ZMK_BRIDGE_UNDERGLOW_PIXELS) || ...ANIMATION
+
+static int underglow_work_q_init(void) {
+#if PIXELS_LUT_NEEDED
+    led_color_lut_build(pixels_lut, IS_ENABLED(CONFIG_ZMK_BRIDGE_UNDERGLOW_PIXELS_GAMMA),
+                        CONFIG_ZMK_BRIDGE_UNDERGLOW_PIXELS_BRIGHTNESS);
+#endif // PIXELS_LUT_NEEDED
+
+    k_work_queue_start(&underglow_work_q, underglow_work_q_stack,
+                       K_THREAD_STACK_SIZEOF(underglow_work_q_stack),
+                       K_LOWEST_APPLICATION_THREAD_PRIO, NULL);
+
+    k_spinlock_key_t key = k_spin_lock(&color_state_lock);
+    underglow_work_q_started = true;
+    const bool loaded = color_state_loaded;
+    const struct zmk_led_hsb state = color_state;
+    k_spin_unlock(&color_state_lock, key);
+
+    if (loaded) {
+        update_color_state(state);
+    }
+    return 0;
+}
+
+SYS_INIT(underglow_work_q_init, APPLICATION, CONFIG_APPLICATION_INIT_PRIORITY);
+
 BRIDGE_SUBSYSTEM_HANDLER(underglow, reset);
 BRIDGE_SUBSYSTEM_HANDLER(underglow, set_ug_cmd);
 BRIDGE_SUBSYSTEM_HANDLER(underglow, set_hsb);
@@ -0,0 +1,115 @@
+/*
+ * Copyright (c) 2025 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <string.h>
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/util.h>
+
+#include <bridge_transport.h>
+#include <zmk/bridge_loopback.h>
+
+struct loopback_session_data {
+    // Given by the Bridge core, taken by the host side.
+    struct k_sem tx_sem;
+    struct k_sem rx_sem;
+    // Given by the host side, taken by the Bridge core.
+    struct k_sem room_sem;
+};
+
+static int loopback_init(const struct bridge_session *session) {
+    struct loopback_session_data *data = session->data;
+
+    k_sem_init(&data->tx_sem, 0, 1);
+    k_sem_init(&data->rx_sem, 0, 1);
+    k_sem_init(&data->room_sem, 0, 1);
+    return 0;
+}
+
+static void loopback_tx_submit(const struct bridge_session *session, bool frame_done) {
+    struct loopback_session_data *data = session->data;
+    k_sem_give(&data->tx_sem);
+}
+
+static void loopback_tx_wait(const struct bridge_session *session) {
+    struct loopback_session_data *data = session->data;
+    k_sem_give(&data->tx_sem);
+    k_sem_take(&data->room_sem, K_FOREVER);
+}
+
+static void loopback_rx_resume(const struct bridge_session *session) {
+    struct loopback_session_data *data = session->data;
+    k_sem_give(&data->rx_sem);
+}
+
+static const struct bridge_transport_api loopback_api = {
+    .init = loopback_init,
+    .tx_submit = loopback_tx_submit,
+    .tx_wait = loopback_tx_wait,
+    .rx_resume = loopback_rx_resume,
+};
+
+// Wakes the host side once per frame, or when the TX queue fills up.
+#define LOOPBACK_SESSION_DEFINE(n, _)                                                              \
+    static struct loopback_session_data bridge_loopback_##n##_data;                                \
+    BRIDGE_SESSION_DEFINE(bridge_loopback_##n, &loopback_api, NULL, &bridge_loopback_##n##_data,   \
+                          CONFIG_ZMK_BRIDGE_TX_BUF_SIZE)
+
+LISTIFY(CONFIG_ZMK_BRIDGE_LOOPBACK_SESSIONS, LOOPBACK_SESSION_DEFINE, ())
+
+#define LOOPBACK_SESSION_REF(n, _) &bridge_loopback_##n
+
+static const struct bridge_session *const loopback_sessions[] = {
+    LISTIFY(CONFIG_ZMK_BRIDGE_LOOPBACK_SESSIONS, LOOPBACK_SESSION_REF, (, ))};
+
+int bridge_loopback_send(uint8_t index, const uint8_t *buf, size_t len, k_timeout_t timeout) {
+    if (index >= ARRAY_SIZE(loopback_sessions)) {
+        return -EINVAL;
+    }
+
+    const struct bridge_session *session = loopback_sessions[index];
+    struct loopback_session_data *data = session->data;
+
+    while (!bridge_transport_rx_ready(session)) {
+        if (k_sem_take(&data->rx_sem, timeout) < 0) {
+            return -EAGAIN;
+        }
+    }
+
+    bridge_transport_rx(session, buf, len);
+    return 0;
+}
+
+size_t bridge_loopback_receive(uint8_t index, uint8_t *buf, size_t len, k_timeout_t timeout) {
+    if (index >= ARRAY_SIZE(loopback_sessions)) {
+        return 0;
+    }
+
+    const struct bridge_session *session = loopback_sessions[index];
+    struct loopback_session_data *data = session->data;
+    size_t received = 0;
+
+    for (;;) {
+        uint8_t *claimed;
+        uint32_t claim_len;
+
+        while (received < len &&
+               (claim_len = bridge_transport_tx_claim(session, &claimed, len - received)) > 0) {
+            memcpy(&buf[received], claimed, claim_len);
+            bridge_transport_tx_finish(session, claim_len);
+            received += claim_len;
+        }
+
+        if (received > 0) {
+            k_sem_give(&data->room_sem);
+            return received;
+        }
+
+        if (k_sem_take(&data->tx_sem, timeout) < 0) {
+            return 0;
+        }
+    }
+}
@@ -0,0 +1,259 @@
+/*
+ * Copyright (c) 2025 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#define DT_DRV_COMPAT zmk_bridge_uart
+
+#include <zephyr/drivers/uart.h>
+#include <zephyr/logging/log.h>
+
+#include <bridge_transport.h>
+
+LOG_MODULE_DECLARE(zmk_bridge, CONFIG_ZMK_BRIDGE_LOG_LEVEL);
+
+struct uart_session_config {
+    const struct device *dev;
+#if IS_ENABLED(CONFIG_ZMK_BRIDGE_UART_RX_MODE_POLL)
+    k_thread_stack_t *rx_stack;
+    size_t rx_stack_size;
+#endif // IS_ENABLED(CONFIG_ZMK_BRIDGE_UART_RX_MODE_POLL)
+};
+
+struct uart_session_data {
+#if IS_ENABLED(CONFIG_ZMK_BRIDGE_UART_RX_MODE_INTERRUPT)
+    atomic_t rx_paused;
+#else
+    struct k_thread rx_thread;
+#endif // IS_ENABLED(CONFIG_ZMK_BRIDGE_UART_RX_MODE_INTERRUPT)
+#if IS_ENABLED(CONFIG_ZMK_BRIDGE_UART_TX_MODE_INTERRUPT)
+    struct k_sem tx_sem;
+#endif // IS_ENABLED(CONFIG_ZMK_BRIDGE_UART_TX_MODE_INTERRUPT)
+};
+
+static const struct device *uart_session_dev(const struct bridge_session *session) {
+    const struct uart_session_config *config = session->config;
+    return config->dev;
+}
+
+#if IS_ENABLED(CONFIG_ZMK_BRIDGE_UART_RX_MODE_INTERRUPT)
+static void uart_rx_resume(const struct bridge_session *session) {
+    struct uart_session_data *data = session->data;
+
+    if (atomic_cas(&data->rx_paused, 1, 0)) {
+        uart_irq_rx_enable(uart_session_dev(session));
+    }
+}
+#endif // IS_ENABLED(CONFIG_ZMK_BRIDGE_UART_RX_MODE_INTERRUPT)
+
+#if IS_ENABLED(CONFIG_ZMK_BRIDGE_UART_TX_MODE_INTERRUPT)
+static void uart_tx_submit(const struct bridge_session *session, bool frame_done) {
+    // The ISR keeps refilling the FIFO from the TX queue and disables itself once it is empty.
+    uart_irq_tx_enable(uart_session_dev(session));
+}
+
+static void uart_tx_wait(const struct bridge_session *session) {
+    struct uart_session_data *data = session->data;
+
+    uart_irq_tx_enable(uart_session_dev(session));
+    k_sem_take(&data->tx_sem, K_FOREVER);
+}
+#else
+static void uart_tx_submit(const struct bridge_session *session, bool frame_done) {
+    const struct device *dev = uart_session_dev(session);
+    uint8_t *buf;
+    uint32_t claim_len;
+
+    while ((claim_len = bridge_transport_tx_claim(session, &buf, CONFIG_ZMK_BRIDGE_TX_BUF_SIZE)) >
+           0) {
+        for (int i = 0; i < claim_len; i++) {
+            uart_poll_out(dev, buf[i]);
+        }
+
+        bridge_transport_tx_finish(session, claim_len);
+    }
+}
+
+static void uart_tx_wait(const struct bridge_session *session) { uart_tx_submit(session, false); }
+#endif // IS_ENABLED(CONFIG_ZMK_BRIDGE_UART_TX_MODE_INTERRUPT)
+
+#if IS_ENABLED(CONFIG_ZMK_BRIDGE_UART_RX_MODE_INTERRUPT)
+static void uart_isr_rx(const struct device *dev, const struct bridge_session *session) {
+    struct uart_session_data *data = session->data;
+
+    while (uart_irq_rx_ready(dev)) {
+        if (!bridge_transport_rx_ready(session)) {
+            // Leave the data in the FIFO and stop listening until the Bridge core has released
+            // a frame buffer, see uart_rx_resume().
+            atomic_set(&data->rx_paused, 1);
+            uart_irq_rx_disable(dev);
+            break;
+        }
+
+        uint8_t buf[16];
+        int len = uart_fifo_read(dev, buf, sizeof(buf));
+
+        if (len <= 0) {
+            break;
+        }
+
+        bridge_transport_rx(session, buf, len);
+    }
+}
+#endif // IS_ENABLED(CONFIG_ZMK_BRIDGE_UART_RX_MODE_INTERRUPT)
+
+#if IS_ENABLED(CONFIG_ZMK_BRIDGE_UART_TX_MODE_INTERRUPT)
+static void uart_isr_tx(const struct device *dev, const struct bridge_session *session) {
+    struct uart_session_data *data = session->data;
+
+    if (!uart_irq_tx_ready(dev)) {
+        return;
+    }
+
+    uint8_t *buf;
+    uint32_t claim_len = bridge_transport_tx_claim(session, &buf, CONFIG_ZMK_BRIDGE_TX_BUF_SIZE);
+
+    if (claim_len < 1) {
+        uart_irq_tx_disable(dev);
+        return;
+    }
+
+    int len = uart_fifo_fill(dev, buf, claim_len);
+    bridge_transport_tx_finish(session, MAX(len, 0));
+
+    if (len > 0) {
+        k_sem_give(&data->tx_sem);
+    }
+}
+#endif // IS_ENABLED(CONFIG_ZMK_BRIDGE_UART_TX_MODE_INTERRUPT)
+
+#if IS_ENABLED(CONFIG_ZMK_BRIDGE_UART_INTERRUPT_DRIVEN)
+static void uart_isr(const struct device *dev, void *user_data) {
+    const struct bridge_session *session = user_data;
+
+    if (!uart_irq_update(dev)) {
+        return;
+    }
+
+#if IS_ENABLED(CONFIG_ZMK_BRIDGE_UART_RX_MODE_INTERRUPT)
+    uart_isr_rx(dev, session);
+#endif // IS_ENABLED(CONFIG_ZMK_BRIDGE_UART_RX_MODE_INTERRUPT)
+
+#if IS_ENABLED(CONFIG_ZMK_BRIDGE_UART_TX_MODE_INTERRUPT)
+    uart_isr_tx(dev, session);
+#endif // IS_ENABLED(CONFIG_ZMK_BRIDGE_UART_TX_MODE_INTERRUPT)
+}
+#endif // IS_ENABLED(CONFIG_ZMK_BRIDGE_UART_INTERRUPT_DRIVEN)
+
+#if IS_ENABLED(CONFIG_ZMK_BRIDGE_UART_RX_MODE_POLL)
+static void uart_rx_main(void *p1, void *p2, void *p3) {
+    const struct bridge_session *session = p1;
+    const struct device *dev = uart_session_dev(session);
+
+    for (;;) {
+        if (!bridge_transport_rx_ready(session)) {
+            k_sleep(K_MSEC(1));
+            continue;
+        }
+
+        uint8_t buf[16];
+        size_t len = 0;
+        while (len < sizeof(buf) && uart_poll_in(dev, &buf[len]) == 0) {
+            len++;
+        }
+
+        if (len == 0) {
+            k_sleep(K_MSEC(1));
+            continue;
+        }
+
+        bridge_transport_rx(session, buf, len);
+    }
+}
+#endif // IS_ENABLED(CONFIG_ZMK_BRIDGE_UART_RX_MODE_POLL)
+
+static int uart_session_init(const struct bridge_session *session) {
+    const struct uart_session_config *config = session->config;
+    struct uart_session_data *data __maybe_unused = session->data;
+
+    if (!device_is_ready(config->dev)) {
+        LOG_ERR("UART device %s not ready", config->dev->name);
+        return -ENODEV;
+    }
+
+#if IS_ENABLED(CONFIG_ZMK_BRIDGE_UART_TX_MODE_INTERRUPT)
+    k_sem_init(&data->tx_sem, 0, 1);
+#endif // IS_ENABLED(CONFIG_ZMK_BRIDGE_UART_TX_MODE_INTERRUPT)
+
+#if IS_ENABLED(CONFIG_ZMK_BRIDGE_UART_INTERRUPT_DRIVEN)
+    int err = uart_irq_callback_user_data_set(config->dev, uart_isr, (void *)session);
+    if (err < 0) {
+        LOG_ERR("Failed to set the UART IRQ callback %d", err);
+        return err;
+    }
+#endif // IS_ENABLED(CONFIG_ZMK_BRIDGE_UART_INTERRUPT_DRIVEN)
+
+#if IS_ENABLED(CONFIG_ZMK_BRIDGE_UART_RX_MODE_INTERRUPT)
+    uart_irq_rx_enable(config->dev);
+#else
+    k_thread_create(&data->rx_thread, config->rx_stack, config->rx_stack_size, uart_rx_main,
+                    (void *)session, NULL, NULL, K_LOWEST_APPLICATION_THREAD_PRIO, 0, K_NO_WAIT);
+    k_thread_name_set(&data->rx_thread, session->name);
+#endif // IS_ENABLED(CONFIG_ZMK_BRIDGE_UART_RX_MODE_INTERRUPT)
+
+    return 0;
+}
+
+#if IS_ENABLED(CONFIG_ZMK_BRIDGE_UART_RX_MODE_POLL)
+static struct k_thread *uart_rx_thread(const struct bridge_session *session) {
+    struct uart_session_data *data = session->data;
+    return &data->rx_thread;
+}
+#endif // IS_ENABLED(CONFIG_ZMK_BRIDGE_UART_RX_MODE_POLL)
+
+static const struct bridge_transport_api uart_session_api = {
+    .init = uart_session_init,
+    .tx_submit = uart_tx_submit,
+    .tx_wait = uart_tx_wait,
+#if IS_ENABLED(CONFIG_ZMK_BRIDGE_UART_RX_MODE_INTERRUPT)
+    .rx_resume = uart_rx_resume,
+#else
+    .rx_thread = uart_rx_thread,
+#endif // IS_ENABLED(CONFIG_ZMK_BRIDGE_UART_RX_MODE_INTERRUPT)
+};
+
+#if IS_ENABLED(CONFIG_ZMK_BRIDGE_UART_TX_MODE_INTERRUPT)
+#define UART_SESSION_MTU 1
+#else
+// uart_poll_out blocks, so only hand over half of the TX queue at a time.
+#define UART_SESSION_MTU (CONFIG_ZMK_BRIDGE_TX_BUF_SIZE / 2)
+#endif // IS_ENABLED(CONFIG_ZMK_BRIDGE_UART_TX_MODE_INTERRUPT)
+
+#if IS_ENABLED(CONFIG_ZMK_BRIDGE_UART_RX_MODE_POLL)
+#define UART_SESSION_RX_STACK_DEFINE(_name)                                                        \
+    static K_THREAD_STACK_DEFINE(_name##_rx_stack, CONFIG_ZMK_BRIDGE_TRANSPORT_UART_RX_STACK_SIZE);
+#define UART_SESSION_RX_STACK(_name)                                                               \
+    .rx_stack = _name##_rx_stack, .rx_stack_size = K_THREAD_STACK_SIZEOF(_name##_rx_stack),
+#else
+#define UART_SESSION_RX_STACK_DEFINE(_name)
+#define UART_SESSION_RX_STACK(_name)
+#endif // IS_ENABLED(CONFIG_ZMK_BRIDGE_UART_RX_MODE_POLL)
+
+#define UART_SESSION_DEFINE(_name, _node)                                                          \
+    UART_SESSION_RX_STACK_DEFINE(_name)                                                            \
+    static const struct uart_session_config _name##_config = {                                     \
+        .dev = DEVICE_DT_GET(_node),                                                               \
+        UART_SESSION_RX_STACK(_name)};                                                             \
+    static struct uart_session_data _name##_data;                                                  \
+    BRIDGE_SESSION_DEFINE(_name, &uart_session_api, &_name##_config, &_name##_data,                \
+                          UART_SESSION_MTU)
+
+#define UART_SESSION_INST_DEFINE(n) UART_SESSION_DEFINE(bridge_uart_##n, DT_INST_PHANDLE(n, uart))
+
+DT_INST_FOREACH_STATUS_OKAY(UART_SESSION_INST_DEFINE)
+
+// The chosen UART stays the simple way to set up a single host.
+#if DT_HAS_CHOSEN(zmk_bridge_uart)
+UART_SESSION_DEFINE(bridge_uart, DT_CHOSEN(zmk_bridge_uart))
+#endif // DT_HAS_CHOSEN(zmk_bridge_uart)
@@ -0,0 +1,134 @@
+/*
+ * Copyright (c) 2025 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <string.h>
+
+#include <bridge_latency.h>
+#include <core.pb.h>
+
+BUILD_ASSERT(ARRAY_SIZE(((bridge_core_LatencyHistogram *)0)->buckets) == BRIDGE_LATENCY_BUCKETS,
+             "core.options and BRIDGE_LATENCY_BUCKETS disagree");
+BUILD_ASSERT(ARRAY_SIZE(((bridge_core_CommandLatency *)0)->stages) == BRIDGE_LATENCY_STAGE_COUNT,
+             "core.options and BRIDGE_LATENCY_STAGE_COUNT disagree");
+
+struct latency_histogram {
+    uint32_t buckets[BRIDGE_LATENCY_BUCKETS];
+    uint32_t max_us;
+    uint32_t count;
+};
+
+struct latency_command {
+    bool used;
+    uint8_t subsystem;
+    uint8_t request;
+    struct latency_histogram stages[BRIDGE_LATENCY_STAGE_COUNT];
+};
+
+static struct latency_command latency_commands[CONFIG_ZMK_BRIDGE_LATENCY_STATS_MAX_COMMANDS];
+static uint32_t latency_dropped;
+// Recorded from every worker and the async work queue.
+static struct k_spinlock latency_lock;
+
+// nanopb encodes submessages twice, first to size them, so responses are encoded from a copy.
+static struct latency_command latency_snapshot[CONFIG_ZMK_BRIDGE_LATENCY_STATS_MAX_COMMANDS];
+
+static void histogram_add(struct latency_histogram *histogram, uint32_t cycles) {
+    const uint32_t us = k_cyc_to_us_floor32(cycles);
+    // 0 for less than 1 us, otherwise one more than the index of the highest set bit.
+    const uint32_t bucket = us == 0 ? 0 : MIN(32 - __builtin_clz(us), BRIDGE_LATENCY_BUCKETS - 1);
+
+    histogram->buckets[bucket]++;
+    histogram->max_us = MAX(histogram->max_us, us);
+    histogram->count++;
+}
+
+static struct latency_command *find_command(uint8_t subsystem, uint8_t request) {
+    for (int i = 0; i < ARRAY_SIZE(latency_commands); i++) {
+        struct latency_command *command = &latency_commands[i];
+
+        if (!command->used) {
+            command->used = true;
+            command->subsystem = subsystem;
+            command->request = request;
+            return command;
+        }
+
+        if (command->subsystem == subsystem && command->request == request) {
+            return command;
+        }
+    }
+
+    return NULL;
+}
+
+void bridge_latency_record(uint8_t subsystem, uint8_t request,
+                           const struct bridge_latency_stamps *stamps) {
+    k_spinlock_key_t key = k_spin_lock(&latency_lock);
+    struct latency_command *command = find_command(subsystem, request);
+
+    if (command) {
+        // Unsigned differences stay right across a wrap of the cycle counter.
+        histogram_add(&command->stages[BRIDGE_LATENCY_STAGE_DECODE],
+                      stamps->decoded - stamps->received);
+        histogram_add(&command->stages[BRIDGE_LATENCY_STAGE_HANDLE],
+                      stamps->handled - stamps->decoded);
+        histogram_add(&command->stages[BRIDGE_LATENCY_STAGE_RESPOND],
+                      stamps->responded - stamps->handled);
+    } else {
+        latency_dropped++;
+    }
+
+    k_spin_unlock(&latency_lock, key);
+}
+
+void bridge_latency_reset(void) {
+    k_spinlock_key_t key = k_spin_lock(&latency_lock);
+    memset(latency_commands, 0, sizeof(latency_commands));
+    latency_dropped = 0;
+    k_spin_unlock(&latency_lock, key);
+}
+
+uint32_t bridge_latency_snapshot(void) {
+    k_spinlock_key_t key = k_spin_lock(&latency_lock);
+    memcpy(latency_snapshot, latency_commands, sizeof(latency_snapshot));
+    const uint32_t dropped = latency_dropped;
+    k_spin_unlock(&latency_lock, key);
+
+    return dropped;
+}
+
+bool bridge_latency_encode_commands(pb_ostream_t *stream, const pb_field_t *field,
+                                    void *const *arg) {
+    for (int i = 0; i < ARRAY_SIZE(latency_snapshot); i++) {
+        const struct latency_command *command = &latency_snapshot[i];
+
+        if (!command->used) {
+            break;
+        }
+
+        bridge_core_CommandLatency msg = bridge_core_CommandLatency_init_zero;
+        msg.subsystem = command->subsystem;
+        msg.request = command->request;
+        msg.stages_count = BRIDGE_LATENCY_STAGE_COUNT;
+
+        for (int stage = 0; stage < BRIDGE_LATENCY_STAGE_COUNT; stage++) {
+            bridge_core_LatencyHistogram *histogram = &msg.stages[stage];
+
+            histogram->stage = stage;
+            histogram->buckets_count = BRIDGE_LATENCY_BUCKETS;
+            memcpy(histogram->buckets, command->stages[stage].buckets, sizeof(histogram->buckets));
+            histogram->max_us = command->stages[stage].max_us;
+            histogram->count = command->stages[stage].count;
+        }
+
+        if (!pb_encode_tag_for_field(stream, field) ||
+            !pb_encode_submessage(stream, bridge_core_CommandLatency_fields, &msg)) {
+            return false;
+        }
+    }
+
+    return true;
+}
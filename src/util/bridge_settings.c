@@ -0,0 +1,145 @@
+/*
+ * Copyright (c) 2025 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include <zephyr/logging/log.h>
+#include <zephyr/settings/settings.h>
+#include <zephyr/sys/util.h>
+
+#include <bridge_settings.h>
+
+LOG_MODULE_DECLARE(zmk_bridge, CONFIG_ZMK_BRIDGE_LOG_LEVEL);
+
+#define SETTINGS_PREFIX "bridge"
+#define SETTINGS_NAME_MAX 32
+
+// Guards the values and dirty flags, set from the Bridge workers and the subsystems' work queues.
+static struct k_spinlock settings_lock;
+// Stored values still have to be deleted, see bridge_settings_reset().
+static atomic_t settings_reset_pending;
+// Uptime by which the pending write has to happen, 0 when none is pending. Guarded by the lock.
+static int64_t settings_save_deadline;
+
+static void settings_save_work_handler(struct k_work *work) {
+    char name[SETTINGS_NAME_MAX];
+
+    // Cleared first, a change made during the write starts a new deadline.
+    k_spinlock_key_t key = k_spin_lock(&settings_lock);
+    settings_save_deadline = 0;
+    k_spin_unlock(&settings_lock, key);
+
+    if (atomic_cas(&settings_reset_pending, 1, 0)) {
+        STRUCT_SECTION_FOREACH(bridge_setting, setting) {
+            snprintf(name, sizeof(name), SETTINGS_PREFIX "/%s", setting->key);
+            int err = settings_delete(name);
+            if (err < 0) {
+                LOG_WRN("Failed to delete setting %s %d", name, err);
+            }
+        }
+    }
+
+    STRUCT_SECTION_FOREACH(bridge_setting, setting) {
+        uint8_t value[CONFIG_ZMK_BRIDGE_SETTINGS_MAX_VALUE_SIZE];
+
+        // Copied out, so the flash write does not hold up setters.
+        key = k_spin_lock(&settings_lock);
+        const bool dirty = *setting->dirty;
+        if (dirty) {
+            memcpy(value, setting->value, setting->size);
+            *setting->dirty = false;
+        }
+        k_spin_unlock(&settings_lock, key);
+
+        if (!dirty) {
+            continue;
+        }
+
+        snprintf(name, sizeof(name), SETTINGS_PREFIX "/%s", setting->key);
+        int err = settings_save_one(name, value, setting->size);
+        if (err < 0) {
+            LOG_ERR("Failed to save setting %s %d", name, err);
+        }
+    }
+}
+
+static K_WORK_DELAYABLE_DEFINE(settings_save_work, settings_save_work_handler);
+
+static void schedule_save(void) {
+    k_spinlock_key_t key = k_spin_lock(&settings_lock);
+    const int64_t now = k_uptime_get();
+    if (settings_save_deadline == 0) {
+        settings_save_deadline = now + CONFIG_ZMK_BRIDGE_SETTINGS_SAVE_MAX_DELAY;
+    }
+
+    // Every change pushes the write back, so it only happens once things have settled, but never
+    // past the deadline of the first change.
+    const int64_t delay =
+        CLAMP(settings_save_deadline - now, 0, CONFIG_ZMK_BRIDGE_SETTINGS_SAVE_DEBOUNCE);
+    k_work_reschedule(&settings_save_work, K_MSEC(delay));
+    k_spin_unlock(&settings_lock, key);
+}
+
+void bridge_settings_set(const struct bridge_setting *setting, const void *value) {
+    k_spinlock_key_t key = k_spin_lock(&settings_lock);
+    const bool changed = memcmp(setting->value, value, setting->size) != 0;
+    if (changed) {
+        memcpy(setting->value, value, setting->size);
+        *setting->dirty = true;
+    }
+    k_spin_unlock(&settings_lock, key);
+
+    if (changed) {
+        schedule_save();
+    }
+}
+
+void bridge_settings_reset(void) {
+    STRUCT_SECTION_FOREACH(bridge_setting, setting) {
+        k_spinlock_key_t key = k_spin_lock(&settings_lock);
+        memcpy(setting->value, setting->default_value, setting->size);
+        *setting->dirty = false;
+        k_spin_unlock(&settings_lock, key);
+    }
+
+    atomic_set(&settings_reset_pending, 1);
+    schedule_save();
+}
+
+static int settings_handle_set(const char *name, size_t len, settings_read_cb read_cb,
+                               void *cb_arg) {
+    STRUCT_SECTION_FOREACH(bridge_setting, setting) {
+        const char *next;
+        if (!settings_name_steq(name, setting->key, &next) || next) {
+            continue;
+        }
+
+        if (len != setting->size) {
+            LOG_WRN("Ignoring setting %s with size %zu, expected %zu", name, len, setting->size);
+            return -EINVAL;
+        }
+
+        uint8_t value[CONFIG_ZMK_BRIDGE_SETTINGS_MAX_VALUE_SIZE];
+        const ssize_t read = read_cb(cb_arg, value, len);
+        if (read < 0) {
+            return read;
+        }
+
+        k_spinlock_key_t key = k_spin_lock(&settings_lock);
+        memcpy(setting->value, value, len);
+        k_spin_unlock(&settings_lock, key);
+
+        if (setting->load) {
+            setting->load(value);
+        }
+        return 0;
+    }
+
+    return -ENOENT;
+}
+
+SETTINGS_STATIC_HANDLER_DEFINE(bridge, SETTINGS_PREFIX, NULL, settings_handle_set, NULL, NULL);
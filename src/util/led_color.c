@@ -0,0 +1,158 @@
+/*
+ * Copyright (c) 2025 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <zephyr/sys/util.h>
+
+#include <led_color.h>
+
+// round(255 * (i / 255) ^ 2.2)
+static const uint8_t led_color_gamma[256] = {
+      0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   1,
+      1,   1,   1,   1,   1,   1,   1,   1,   1,   2,   2,   2,   2,   2,   2,   2,
+      3,   3,   3,   3,   3,   4,   4,   4,   4,   5,   5,   5,   5,   6,   6,   6,
+      6,   7,   7,   7,   8,   8,   8,   9,   9,   9,  10,  10,  11,  11,  11,  12,
+     12,  13,  13,  13,  14,  14,  15,  15,  16,  16,  17,  17,  18,  18,  19,  19,
+     20,  20,  21,  22,  22,  23,  23,  24,  25,  25,  26,  26,  27,  28,  28,  29,
+     30,  30,  31,  32,  33,  33,  34,  35,  35,  36,  37,  38,  39,  39,  40,  41,
+     42,  43,  43,  44,  45,  46,  47,  48,  49,  49,  50,  51,  52,  53,  54,  55,
+     56,  57,  58,  59,  60,  61,  62,  63,  64,  65,  66,  67,  68,  69,  70,  71,
+     73,  74,  75,  76,  77,  78,  79,  81,  82,  83,  84,  85,  87,  88,  89,  90,
+     91,  93,  94,  95,  97,  98,  99, 100, 102, 103, 105, 106, 107, 109, 110, 111,
+    113, 114, 116, 117, 119, 120, 121, 123, 124, 126, 127, 129, 130, 132, 133, 135,
+    137, 138, 140, 141, 143, 145, 146, 148, 149, 151, 153, 154, 156, 158, 159, 161,
+    163, 165, 166, 168, 170, 172, 173, 175, 177, 179, 181, 182, 184, 186, 188, 190,
+    192, 194, 196, 197, 199, 201, 203, 205, 207, 209, 211, 213, 215, 217, 219, 221,
+    223, 225, 227, 229, 231, 234, 236, 238, 240, 242, 244, 246, 248, 251, 253, 255,
+};
+
+struct zmk_led_hsb led_color_rgb_to_hsb(struct led_rgb rgb) {
+    const uint32_t max = MAX(rgb.r, MAX(rgb.g, rgb.b));
+    const uint32_t delta = max - MIN(rgb.r, MIN(rgb.g, rgb.b));
+    struct zmk_led_hsb hsb = {
+        .h = 0,
+        .s = max == 0 ? 0 : (delta * LED_COLOR_SAT_MAX + max / 2) / max,
+        .b = (max * LED_COLOR_BRT_MAX + 127) / 255,
+    };
+
+    // Gray has no hue.
+    if (delta == 0) {
+        return hsb;
+    }
+
+    // hue = base + 60 * diff / delta, with diff in [-delta, delta], offset by a full turn so the
+    // numerator stays positive, and doubled to round to nearest.
+    int32_t base;
+    int32_t diff;
+    if (max == rgb.r) {
+        base = 0;
+        diff = (int32_t)rgb.g - rgb.b;
+    } else if (max == rgb.g) {
+        base = 120;
+        diff = (int32_t)rgb.b - rgb.r;
+    } else {
+        base = 240;
+        diff = (int32_t)rgb.r - rgb.g;
+    }
+
+    const uint32_t num = (uint32_t)((LED_COLOR_HUE_MAX + base) * 2 * (int32_t)delta + 120 * diff) +
+                         delta;
+    hsb.h = (num / (2 * delta)) % LED_COLOR_HUE_MAX;
+    return hsb;
+}
+
+/*
+ * channel = round(b / 100 * 255 * (1 - s / 100 * x / 60)), with x the part of the 60 degree
+ * sector that is faded out of the channel, in degrees. The largest numerator is 100 * 255 * 6000.
+ */
+static uint8_t hsb_channel(uint32_t b, uint32_t s, uint32_t x) {
+    const uint32_t num = b * 255 * (LED_COLOR_SAT_MAX * 60 - s * x);
+    return (num + 300000) / 600000;
+}
+
+struct led_rgb led_color_hsb_to_rgb(struct zmk_led_hsb hsb) {
+    const uint32_t h = MIN(hsb.h, LED_COLOR_HUE_MAX - 1);
+    const uint32_t s = MIN(hsb.s, LED_COLOR_SAT_MAX);
+    const uint32_t b = MIN(hsb.b, LED_COLOR_BRT_MAX);
+    const uint32_t f = h % 60;
+
+    const uint8_t v = hsb_channel(b, s, 0);
+    const uint8_t p = hsb_channel(b, s, 60);
+    const uint8_t q = hsb_channel(b, s, f);
+    const uint8_t t = hsb_channel(b, s, 60 - f);
+
+    struct led_rgb rgb = {0};
+    switch (h / 60) {
+    case 0:
+        rgb.r = v, rgb.g = t, rgb.b = p;
+        break;
+    case 1:
+        rgb.r = q, rgb.g = v, rgb.b = p;
+        break;
+    case 2:
+        rgb.r = p, rgb.g = v, rgb.b = t;
+        break;
+    case 3:
+        rgb.r = p, rgb.g = q, rgb.b = v;
+        break;
+    case 4:
+        rgb.r = t, rgb.g = p, rgb.b = v;
+        break;
+    default:
+        rgb.r = v, rgb.g = p, rgb.b = q;
+        break;
+    }
+
+    return rgb;
+}
+
+// Rounded to nearest, |to - from| * t fits as long as the difference stays within 2^15.
+static int32_t lerp(int32_t from, int32_t to, uint32_t t) {
+    const int32_t d = (to - from) * (int32_t)t;
+    return from + (d >= 0 ? (d + 32768) >> 16 : -((-d + 32768) >> 16));
+}
+
+struct zmk_led_hsb led_color_hsb_lerp(struct zmk_led_hsb from, struct zmk_led_hsb to, uint32_t t) {
+    t = MIN(t, 1 << 16);
+
+    int32_t dh = (int32_t)to.h - from.h;
+    if (dh > LED_COLOR_HUE_MAX / 2) {
+        dh -= LED_COLOR_HUE_MAX;
+    } else if (dh < -LED_COLOR_HUE_MAX / 2) {
+        dh += LED_COLOR_HUE_MAX;
+    }
+
+    return (struct zmk_led_hsb){
+        .h = (lerp(from.h, from.h + dh, t) + LED_COLOR_HUE_MAX) % LED_COLOR_HUE_MAX,
+        .s = lerp(from.s, to.s, t),
+        .b = lerp(from.b, to.b, t),
+    };
+}
+
+void led_color_rgb_to_hsb_buf(const struct led_rgb *rgb, struct zmk_led_hsb *hsb, size_t count) {
+    for (size_t i = 0; i < count; i++) {
+        hsb[i] = led_color_rgb_to_hsb(rgb[i]);
+    }
+}
+
+void led_color_hsb_to_rgb_buf(const struct zmk_led_hsb *hsb, struct led_rgb *rgb, size_t count) {
+    for (size_t i = 0; i < count; i++) {
+        rgb[i] = led_color_hsb_to_rgb(hsb[i]);
+    }
+}
+
+void led_color_lut_build(uint8_t lut[256], bool gamma, uint8_t brightness) {
+    for (int i = 0; i < 256; i++) {
+        lut[i] = led_color_scale8(gamma ? led_color_gamma[i] : i, brightness);
+    }
+}
+
+void led_color_lut_apply(const uint8_t lut[256], struct led_rgb *pixels, size_t count) {
+    for (size_t i = 0; i < count; i++) {
+        pixels[i].r = lut[pixels[i].r];
+        pixels[i].g = lut[pixels[i].g];
+        pixels[i].b = lut[pixels[i].b];
+    }
+}
@@ -4,11 +4,60 @@
  * SPDX-License-Identifier: MIT
  */
 
+#include <string.h>
+
 #include <uart_framing.h>
 #include <zephyr/logging/log.h>
+#include <zephyr/sys/byteorder.h>
+#include <zephyr/sys/crc.h>
 
 LOG_MODULE_DECLARE(zmk_bridge, CONFIG_ZMK_BRIDGE_LOG_LEVEL);
 
+// The framing bytes are consecutive, which lets us test for all of them with a single compare.
+BUILD_ASSERT(FRAMING_ESC == FRAMING_SOF + 1 && FRAMING_EOF == FRAMING_SOF + 2);
+
+#define FRAMING_WORD_ONES (~0UL / 0xFF)
+#define FRAMING_WORD_HIGHS (FRAMING_WORD_ONES * 0x80)
+#define FRAMING_WORD_HAS_ZERO(w) (((w) - FRAMING_WORD_ONES) & ~(w) & FRAMING_WORD_HIGHS)
+#define FRAMING_WORD_HAS_BYTE(w, c) FRAMING_WORD_HAS_ZERO((w) ^ (FRAMING_WORD_ONES * (c)))
+
+static inline bool _is_framing_byte(uint8_t c) {
+    return (uint8_t)(c - FRAMING_SOF) <= (FRAMING_EOF - FRAMING_SOF);
+}
+
+static inline bool _word_has_framing_byte(unsigned long w) {
+    return FRAMING_WORD_HAS_BYTE(w, FRAMING_SOF) || FRAMING_WORD_HAS_BYTE(w, FRAMING_ESC) ||
+           FRAMING_WORD_HAS_BYTE(w, FRAMING_EOF);
+}
+
+/* Length of the leading run of bytes that need no framing treatment, scanned a word at a time. */
+static size_t _plain_run_len(const uint8_t *buf, size_t len) {
+    size_t i = 0;
+
+    while (i < len && ((uintptr_t)&buf[i] % sizeof(unsigned long)) != 0) {
+        if (_is_framing_byte(buf[i])) {
+            return i;
+        }
+        i++;
+    }
+
+    for (; i + sizeof(unsigned long) <= len; i += sizeof(unsigned long)) {
+        unsigned long w;
+        memcpy(&w, &buf[i], sizeof(w));
+        if (_word_has_framing_byte(w)) {
+            break;
+        }
+    }
+
+    for (; i < len; i++) {
+        if (_is_framing_byte(buf[i])) {
+            break;
+        }
+    }
+
+    return i;
+}
+
 static bool _process_byte_err_state(enum uart_framing_state *uart_fs, uint8_t c) {
     switch (c) {
     case FRAMING_EOF:
@@ -40,7 +89,7 @@ static bool _process_byte_idle_state(enum uart_framing_state *uart_fs, uint8_t c
 static bool _process_byte_awaiting_data_state(enum uart_framing_state *uart_fs, uint8_t c) {
     switch (c) {
     case FRAMING_SOF:
-        // LOG_WRN("Unescaped SOF mid-data");
+        // Aborts the frame, see uart_framing_decoder_resync().
         *uart_fs = FRAMING_STATE_ERR;
         return false;
     case FRAMING_ESC:
@@ -76,4 +125,332 @@ bool uart_framing_process_byte(enum uart_framing_state *uart_fs, uint8_t c) {
         LOG_ERR("Unsupported framing state: %d", *uart_fs);
         return false;
     }
-}
\ No newline at end of file
+}
+
+static size_t _escape_decode(enum uart_framing_state *uart_fs, const uint8_t *in, size_t in_len,
+                             size_t *consumed, uint8_t *out, size_t out_len) {
+    size_t in_idx = 0;
+    size_t out_idx = 0;
+
+    while (in_idx < in_len && out_idx < out_len) {
+        if (*uart_fs == FRAMING_STATE_AWAITING_DATA) {
+            const size_t run =
+                _plain_run_len(&in[in_idx], MIN(in_len - in_idx, out_len - out_idx));
+
+            memcpy(&out[out_idx], &in[in_idx], run);
+            in_idx += run;
+            out_idx += run;
+
+            if (in_idx == in_len || out_idx == out_len) {
+                break;
+            }
+        }
+
+        const enum uart_framing_state prev_fs = *uart_fs;
+        const uint8_t c = in[in_idx++];
+        if (uart_framing_process_byte(uart_fs, c)) {
+            out[out_idx++] = c;
+        }
+
+        if (*uart_fs == FRAMING_STATE_EOF ||
+            (*uart_fs == FRAMING_STATE_ERR && prev_fs != FRAMING_STATE_ERR)) {
+            break;
+        }
+    }
+
+    *consumed = in_idx;
+    return out_idx;
+}
+
+static size_t _escape_encode(struct uart_framing_encoder *enc, const uint8_t *in, size_t in_len,
+                             size_t *consumed, uint8_t *out, size_t out_len) {
+    size_t in_idx = 0;
+    size_t out_idx = 0;
+
+    while (in_idx < in_len && out_idx < out_len) {
+        if (enc->start_pending) {
+            out[out_idx++] = FRAMING_SOF;
+            enc->start_pending = false;
+            continue;
+        }
+
+        if (enc->escape_pending) {
+            out[out_idx++] = in[in_idx++];
+            enc->escape_pending = false;
+            continue;
+        }
+
+        const size_t run = _plain_run_len(&in[in_idx], MIN(in_len - in_idx, out_len - out_idx));
+
+        memcpy(&out[out_idx], &in[in_idx], run);
+        in_idx += run;
+        out_idx += run;
+
+        if (in_idx == in_len || out_idx == out_len) {
+            break;
+        }
+
+        out[out_idx++] = FRAMING_ESC;
+        enc->escape_pending = true;
+    }
+
+    *consumed = in_idx;
+    return out_idx;
+}
+
+static size_t _escape_encode_end(struct uart_framing_encoder *enc, uint8_t *out, size_t out_len,
+                                 bool *done) {
+    size_t out_idx = 0;
+
+    if (enc->start_pending && out_idx < out_len) {
+        out[out_idx++] = FRAMING_SOF;
+        enc->start_pending = false;
+    }
+
+    *done = !enc->start_pending && out_idx < out_len;
+    if (*done) {
+        out[out_idx++] = FRAMING_EOF;
+    }
+
+    return out_idx;
+}
+
+#if IS_ENABLED(CONFIG_ZMK_BRIDGE_FRAMING_COBS)
+
+static inline void _cobs_start_block(uint8_t *left, bool *zero, uint8_t code) {
+    *left = code - 1;
+    // A full block is not followed by a zero, any other block is, except for the last one.
+    *zero = code != 0xFF;
+}
+
+static size_t _cobs_decode(struct uart_framing_decoder *dec, const uint8_t *in, size_t in_len,
+                           size_t *consumed, uint8_t *out, size_t out_len) {
+    size_t in_idx = 0;
+    size_t out_idx = 0;
+
+    while (in_idx < in_len) {
+        const uint8_t c = in[in_idx];
+
+        if (dec->state != FRAMING_STATE_AWAITING_DATA) {
+            // Between frames, any byte but the delimiter starts the first block of a new frame.
+            in_idx++;
+            if (c != 0) {
+                dec->state = FRAMING_STATE_AWAITING_DATA;
+                _cobs_start_block(&dec->cobs_left, &dec->cobs_zero, c);
+            }
+        } else if (dec->cobs_left > 0) {
+            if (out_idx == out_len) {
+                break;
+            }
+
+            const size_t len = MIN(dec->cobs_left, MIN(in_len - in_idx, out_len - out_idx));
+            const uint8_t *zero = memchr(&in[in_idx], 0, len);
+            const size_t run = zero ? (size_t)(zero - &in[in_idx]) : len;
+
+            memcpy(&out[out_idx], &in[in_idx], run);
+            in_idx += run;
+            out_idx += run;
+            dec->cobs_left -= run;
+
+            if (zero) {
+                LOG_WRN("COBS frame ended in the middle of a block");
+                in_idx++;
+                dec->state = FRAMING_STATE_ERR;
+                break;
+            }
+        } else if (c == 0) {
+            // The zero the last block would end in is not part of the data.
+            in_idx++;
+            dec->state = FRAMING_STATE_EOF;
+            break;
+        } else {
+            if (dec->cobs_zero) {
+                if (out_idx == out_len) {
+                    break;
+                }
+                out[out_idx++] = 0;
+            }
+
+            in_idx++;
+            _cobs_start_block(&dec->cobs_left, &dec->cobs_zero, c);
+        }
+    }
+
+    *consumed = in_idx;
+    return out_idx;
+}
+
+static void _cobs_complete_block(struct uart_framing_encoder *enc) {
+    enc->cobs_block[0] = enc->cobs_len;
+    enc->cobs_written = 0;
+    enc->cobs_flushing = true;
+}
+
+static size_t _cobs_flush_block(struct uart_framing_encoder *enc, uint8_t *out, size_t out_len) {
+    const size_t len = MIN(enc->cobs_len - enc->cobs_written, out_len);
+
+    memcpy(out, &enc->cobs_block[enc->cobs_written], len);
+    enc->cobs_written += len;
+
+    if (enc->cobs_written == enc->cobs_len) {
+        enc->cobs_flushing = false;
+        enc->cobs_len = 1;
+    }
+
+    return len;
+}
+
+static size_t _cobs_encode(struct uart_framing_encoder *enc, const uint8_t *in, size_t in_len,
+                           size_t *consumed, uint8_t *out, size_t out_len) {
+    size_t in_idx = 0;
+    size_t out_idx = 0;
+
+    for (;;) {
+        if (enc->cobs_flushing) {
+            out_idx += _cobs_flush_block(enc, &out[out_idx], out_len - out_idx);
+            if (enc->cobs_flushing) {
+                break;
+            }
+        }
+
+        if (in_idx == in_len) {
+            break;
+        }
+
+        const size_t len = MIN(sizeof(enc->cobs_block) - enc->cobs_len, in_len - in_idx);
+        const uint8_t *zero = memchr(&in[in_idx], 0, len);
+        const size_t run = zero ? (size_t)(zero - &in[in_idx]) : len;
+
+        memcpy(&enc->cobs_block[enc->cobs_len], &in[in_idx], run);
+        enc->cobs_len += run;
+        in_idx += run;
+
+        if (zero) {
+            in_idx++;
+            _cobs_complete_block(enc);
+        } else if (enc->cobs_len == sizeof(enc->cobs_block)) {
+            _cobs_complete_block(enc);
+        }
+    }
+
+    *consumed = in_idx;
+    return out_idx;
+}
+
+static size_t _cobs_encode_end(struct uart_framing_encoder *enc, uint8_t *out, size_t out_len,
+                               bool *done) {
+    size_t out_idx = 0;
+
+    if (!enc->cobs_final && !enc->cobs_flushing) {
+        enc->cobs_final = true;
+        _cobs_complete_block(enc);
+    }
+
+    if (enc->cobs_flushing) {
+        out_idx += _cobs_flush_block(enc, out, out_len);
+    }
+
+    *done = enc->cobs_final && !enc->cobs_flushing && out_idx < out_len;
+    if (*done) {
+        out[out_idx++] = 0;
+    }
+
+    return out_idx;
+}
+
+#endif // IS_ENABLED(CONFIG_ZMK_BRIDGE_FRAMING_COBS)
+
+void uart_framing_decoder_init(struct uart_framing_decoder *dec, enum uart_framing_codec codec) {
+    *dec = (struct uart_framing_decoder){
+        .codec = codec,
+        .state = FRAMING_STATE_IDLE,
+    };
+}
+
+void uart_framing_decoder_resync(struct uart_framing_decoder *dec) {
+    dec->state = dec->codec == UART_FRAMING_CODEC_ESCAPE ? FRAMING_STATE_AWAITING_DATA
+                                                         : FRAMING_STATE_IDLE;
+}
+
+size_t uart_framing_decode(struct uart_framing_decoder *dec, const uint8_t *in, size_t in_len,
+                           size_t *consumed, uint8_t *out, size_t out_len) {
+#if IS_ENABLED(CONFIG_ZMK_BRIDGE_FRAMING_COBS)
+    if (dec->codec == UART_FRAMING_CODEC_COBS) {
+        return _cobs_decode(dec, in, in_len, consumed, out, out_len);
+    }
+#endif // IS_ENABLED(CONFIG_ZMK_BRIDGE_FRAMING_COBS)
+
+    return _escape_decode(&dec->state, in, in_len, consumed, out, out_len);
+}
+
+void uart_framing_encoder_init(struct uart_framing_encoder *enc, enum uart_framing_codec codec) {
+    enc->codec = codec;
+    enc->start_pending = codec == UART_FRAMING_CODEC_ESCAPE;
+    enc->escape_pending = false;
+#if IS_ENABLED(CONFIG_ZMK_BRIDGE_FRAMING_COBS)
+    enc->cobs_len = 1;
+    enc->cobs_flushing = false;
+    enc->cobs_final = false;
+#endif // IS_ENABLED(CONFIG_ZMK_BRIDGE_FRAMING_COBS)
+}
+
+size_t uart_framing_encode(struct uart_framing_encoder *enc, const uint8_t *in, size_t in_len,
+                           size_t *consumed, uint8_t *out, size_t out_len) {
+#if IS_ENABLED(CONFIG_ZMK_BRIDGE_FRAMING_COBS)
+    if (enc->codec == UART_FRAMING_CODEC_COBS) {
+        return _cobs_encode(enc, in, in_len, consumed, out, out_len);
+    }
+#endif // IS_ENABLED(CONFIG_ZMK_BRIDGE_FRAMING_COBS)
+
+    return _escape_encode(enc, in, in_len, consumed, out, out_len);
+}
+
+size_t uart_framing_encode_end(struct uart_framing_encoder *enc, uint8_t *out, size_t out_len,
+                               bool *done) {
+#if IS_ENABLED(CONFIG_ZMK_BRIDGE_FRAMING_COBS)
+    if (enc->codec == UART_FRAMING_CODEC_COBS) {
+        return _cobs_encode_end(enc, out, out_len, done);
+    }
+#endif // IS_ENABLED(CONFIG_ZMK_BRIDGE_FRAMING_COBS)
+
+    return _escape_encode_end(enc, out, out_len, done);
+}
+
+uint32_t uart_framing_check_init(void) {
+#if IS_ENABLED(CONFIG_ZMK_BRIDGE_FRAME_CHECK_CRC16)
+    return 0xFFFF;
+#else
+    return 0;
+#endif // IS_ENABLED(CONFIG_ZMK_BRIDGE_FRAME_CHECK_CRC16)
+}
+
+uint32_t uart_framing_check_update(uint32_t check, const uint8_t *data, size_t len) {
+#if IS_ENABLED(CONFIG_ZMK_BRIDGE_FRAME_CHECK_CRC32)
+    return crc32_ieee_update(check, data, len);
+#elif IS_ENABLED(CONFIG_ZMK_BRIDGE_FRAME_CHECK_CRC16)
+    return crc16_itu_t(check, data, len);
+#else
+    return check;
+#endif // IS_ENABLED(CONFIG_ZMK_BRIDGE_FRAME_CHECK_CRC32)
+}
+
+void uart_framing_check_put(uint32_t check, uint8_t *out) {
+#if IS_ENABLED(CONFIG_ZMK_BRIDGE_FRAME_CHECK_CRC32)
+    sys_put_le32(check, out);
+#elif IS_ENABLED(CONFIG_ZMK_BRIDGE_FRAME_CHECK_CRC16)
+    sys_put_le16(check, out);
+#endif // IS_ENABLED(CONFIG_ZMK_BRIDGE_FRAME_CHECK_CRC32)
+}
+
+bool uart_framing_check_frame(const uint8_t *frame, size_t len) {
+    if (len < UART_FRAMING_CHECK_LEN) {
+        return false;
+    }
+
+    const size_t data_len = len - UART_FRAMING_CHECK_LEN;
+    uint8_t expected[MAX(UART_FRAMING_CHECK_LEN, 1)];
+
+    uart_framing_check_put(
+        uart_framing_check_update(uart_framing_check_init(), frame, data_len), expected);
+    return memcmp(expected, &frame[data_len], UART_FRAMING_CHECK_LEN) == 0;
+}
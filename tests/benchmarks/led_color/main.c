@@ -0,0 +1,268 @@
+/*
+ * Copyright (c) 2025 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+/*
+ * Throughput of the integer color code against the float code it replaced, on the host. The float
+ * RGB to HSB conversion is the one underglow.c used before, with gray guarded, and HSB to RGB is
+ * ZMK's hsb_to_rgb(). Rates count pixels. Hosts have an FPU, a Cortex-M0 runs the float code in
+ * soft-float and falls much further behind.
+ */
+
+#include <math.h>
+#include <time.h>
+
+#include <zephyr/ztest.h>
+
+#include <led_color.h>
+
+#define PIXEL_COUNT 1024
+#define REPEAT 1024
+
+static struct led_rgb rgb_in[PIXEL_COUNT];
+static struct zmk_led_hsb hsb_in[PIXEL_COUNT];
+static uint32_t lerp_t[PIXEL_COUNT];
+static struct led_rgb rgb_out[PIXEL_COUNT];
+static struct zmk_led_hsb hsb_out[PIXEL_COUNT];
+static struct led_rgb rgb_ref[PIXEL_COUNT];
+static struct zmk_led_hsb hsb_ref[PIXEL_COUNT];
+
+static uint64_t now_ns(void) {
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * NSEC_PER_SEC + ts.tv_nsec;
+}
+
+static double rate_mpps(uint64_t elapsed_ns) {
+    // Pixels per us are Mpx/s.
+    return 1000.0 * PIXEL_COUNT * REPEAT / elapsed_ns;
+}
+
+static struct zmk_led_hsb float_rgb_to_hsb(struct led_rgb rgb) {
+    struct zmk_led_hsb hsb_color = {0};
+
+    float r_n = (float)rgb.r / 255;
+    float g_n = (float)rgb.g / 255;
+    float b_n = (float)rgb.b / 255;
+
+    float c_max = MAX(r_n, MAX(g_n, b_n));
+    float delta = c_max - MIN(r_n, MIN(g_n, b_n));
+
+    if (delta == 0) {
+        hsb_color.h = 0;
+    } else if (c_max == r_n) {
+        hsb_color.h = (uint32_t)((60 * (g_n - b_n) / delta) + 360) % 360;
+    } else if (c_max == g_n) {
+        hsb_color.h = (uint32_t)((60 * (b_n - r_n) / delta) + 120) % 360;
+    } else {
+        hsb_color.h = (uint32_t)((60 * (r_n - g_n) / delta) + 240) % 360;
+    }
+
+    hsb_color.s = c_max == 0 ? 0 : (delta / c_max) * 100;
+    hsb_color.b = c_max * 100;
+
+    return hsb_color;
+}
+
+static struct led_rgb float_hsb_to_rgb(struct zmk_led_hsb hsb) {
+    float r = 0, g = 0, b = 0;
+
+    uint8_t i = hsb.h / 60;
+    float v = hsb.b / ((float)LED_COLOR_BRT_MAX);
+    float s = hsb.s / ((float)LED_COLOR_SAT_MAX);
+    float f = hsb.h / ((float)LED_COLOR_HUE_MAX) * 6 - i;
+    float p = v * (1 - s);
+    float q = v * (1 - (s * f));
+    float t = v * (1 - (s * (1 - f)));
+
+    switch (i % 6) {
+    case 0:
+        r = v, g = t, b = p;
+        break;
+    case 1:
+        r = q, g = v, b = p;
+        break;
+    case 2:
+        r = p, g = v, b = t;
+        break;
+    case 3:
+        r = p, g = q, b = v;
+        break;
+    case 4:
+        r = t, g = p, b = v;
+        break;
+    case 5:
+        r = v, g = p, b = q;
+        break;
+    }
+
+    return (struct led_rgb){.r = r * 255, .g = g * 255, .b = b * 255};
+}
+
+static struct zmk_led_hsb float_hsb_lerp(struct zmk_led_hsb from, struct zmk_led_hsb to, float t) {
+    float dh = (float)to.h - from.h;
+    if (dh > LED_COLOR_HUE_MAX / 2) {
+        dh -= LED_COLOR_HUE_MAX;
+    } else if (dh < -LED_COLOR_HUE_MAX / 2) {
+        dh += LED_COLOR_HUE_MAX;
+    }
+
+    return (struct zmk_led_hsb){
+        .h = (uint32_t)(from.h + dh * t + LED_COLOR_HUE_MAX + 0.5f) % LED_COLOR_HUE_MAX,
+        .s = from.s + (to.s - from.s) * t + 0.5f,
+        .b = from.b + (to.b - from.b) * t + 0.5f,
+    };
+}
+
+static uint8_t float_gamma(uint8_t value, uint8_t brightness) {
+    return powf(value / 255.0f, 2.2f) * brightness + 0.5f;
+}
+
+static int hue_distance(int a, int b) {
+    const int d = abs(a - b);
+    return MIN(d, LED_COLOR_HUE_MAX - d);
+}
+
+static void *benchmark_setup(void) {
+    // xorshift32, so every run measures the same colors.
+    uint32_t state = 0x2545F491;
+
+    for (int i = 0; i < PIXEL_COUNT; i++) {
+        uint32_t v[2];
+        for (int j = 0; j < ARRAY_SIZE(v); j++) {
+            state ^= state << 13;
+            state ^= state >> 17;
+            state ^= state << 5;
+            v[j] = state;
+        }
+
+        rgb_in[i] = (struct led_rgb){.r = v[0], .g = v[0] >> 8, .b = v[0] >> 16};
+        hsb_in[i] = (struct zmk_led_hsb){
+            .h = v[1] % LED_COLOR_HUE_MAX,
+            .s = (v[1] >> 9) % (LED_COLOR_SAT_MAX + 1),
+            .b = (v[1] >> 17) % (LED_COLOR_BRT_MAX + 1),
+        };
+        lerp_t[i] = (v[0] >> 8) % ((1 << 16) + 1);
+    }
+
+    return NULL;
+}
+
+ZTEST_SUITE(led_color_benchmark, NULL, benchmark_setup, NULL, NULL, NULL);
+
+ZTEST(led_color_benchmark, test_rgb_to_hsb) {
+    uint64_t start = now_ns();
+    for (int r = 0; r < REPEAT; r++) {
+        led_color_rgb_to_hsb_buf(rgb_in, hsb_out, PIXEL_COUNT);
+    }
+    const uint64_t integer_ns = now_ns() - start;
+
+    start = now_ns();
+    for (int r = 0; r < REPEAT; r++) {
+        for (int i = 0; i < PIXEL_COUNT; i++) {
+            hsb_ref[i] = float_rgb_to_hsb(rgb_in[i]);
+        }
+    }
+    const uint64_t float_ns = now_ns() - start;
+
+    // The float code truncates where the integer code rounds.
+    for (int i = 0; i < PIXEL_COUNT; i++) {
+        zassert_true(hue_distance(hsb_out[i].h, hsb_ref[i].h) <= 1, "Hue of pixel %d", i);
+        zassert_between_inclusive(hsb_out[i].s - hsb_ref[i].s, 0, 1, "Saturation of pixel %d", i);
+        zassert_between_inclusive(hsb_out[i].b - hsb_ref[i].b, 0, 1, "Brightness of pixel %d", i);
+    }
+
+    TC_PRINT("RGB to HSB: integer %.0f Mpx/s, float %.0f Mpx/s\n", rate_mpps(integer_ns),
+             rate_mpps(float_ns));
+}
+
+ZTEST(led_color_benchmark, test_hsb_to_rgb) {
+    uint64_t start = now_ns();
+    for (int r = 0; r < REPEAT; r++) {
+        led_color_hsb_to_rgb_buf(hsb_in, rgb_out, PIXEL_COUNT);
+    }
+    const uint64_t integer_ns = now_ns() - start;
+
+    start = now_ns();
+    for (int r = 0; r < REPEAT; r++) {
+        for (int i = 0; i < PIXEL_COUNT; i++) {
+            rgb_ref[i] = float_hsb_to_rgb(hsb_in[i]);
+        }
+    }
+    const uint64_t float_ns = now_ns() - start;
+
+    for (int i = 0; i < PIXEL_COUNT; i++) {
+        zassert_between_inclusive(rgb_out[i].r - rgb_ref[i].r, 0, 1, "Red of pixel %d", i);
+        zassert_between_inclusive(rgb_out[i].g - rgb_ref[i].g, 0, 1, "Green of pixel %d", i);
+        zassert_between_inclusive(rgb_out[i].b - rgb_ref[i].b, 0, 1, "Blue of pixel %d", i);
+    }
+
+    TC_PRINT("HSB to RGB: integer %.0f Mpx/s, float %.0f Mpx/s\n", rate_mpps(integer_ns),
+             rate_mpps(float_ns));
+}
+
+ZTEST(led_color_benchmark, test_hsb_lerp) {
+    uint64_t start = now_ns();
+    for (int r = 0; r < REPEAT; r++) {
+        for (int i = 0; i < PIXEL_COUNT; i++) {
+            hsb_out[i] = led_color_hsb_lerp(hsb_in[i], hsb_in[(i + 1) % PIXEL_COUNT], lerp_t[i]);
+        }
+    }
+    const uint64_t integer_ns = now_ns() - start;
+
+    start = now_ns();
+    for (int r = 0; r < REPEAT; r++) {
+        for (int i = 0; i < PIXEL_COUNT; i++) {
+            hsb_ref[i] = float_hsb_lerp(hsb_in[i], hsb_in[(i + 1) % PIXEL_COUNT],
+                                        lerp_t[i] / 65536.0f);
+        }
+    }
+    const uint64_t float_ns = now_ns() - start;
+
+    for (int i = 0; i < PIXEL_COUNT; i++) {
+        zassert_true(hue_distance(hsb_out[i].h, hsb_ref[i].h) <= 1, "Hue of pixel %d", i);
+        zassert_within(hsb_out[i].s, hsb_ref[i].s, 1, "Saturation of pixel %d", i);
+        zassert_within(hsb_out[i].b, hsb_ref[i].b, 1, "Brightness of pixel %d", i);
+    }
+
+    TC_PRINT("HSB lerp: integer %.0f Mpx/s, float %.0f Mpx/s\n", rate_mpps(integer_ns),
+             rate_mpps(float_ns));
+}
+
+ZTEST(led_color_benchmark, test_gamma) {
+    const uint8_t brightness = 192;
+    uint8_t lut[256];
+
+    // Built once when the underglow subsystem starts, so it is not timed.
+    led_color_lut_build(lut, true, brightness);
+
+    uint64_t start = now_ns();
+    for (int r = 0; r < REPEAT; r++) {
+        memcpy(rgb_out, rgb_in, sizeof(rgb_out));
+        led_color_lut_apply(lut, rgb_out, PIXEL_COUNT);
+    }
+    const uint64_t integer_ns = now_ns() - start;
+
+    start = now_ns();
+    for (int r = 0; r < REPEAT; r++) {
+        for (int i = 0; i < PIXEL_COUNT; i++) {
+            rgb_ref[i].r = float_gamma(rgb_in[i].r, brightness);
+            rgb_ref[i].g = float_gamma(rgb_in[i].g, brightness);
+            rgb_ref[i].b = float_gamma(rgb_in[i].b, brightness);
+        }
+    }
+    const uint64_t float_ns = now_ns() - start;
+
+    // The table rounds twice, once for gamma and once for brightness.
+    for (int i = 0; i < PIXEL_COUNT; i++) {
+        zassert_within(rgb_out[i].r, rgb_ref[i].r, 1, "Red of pixel %d", i);
+        zassert_within(rgb_out[i].g, rgb_ref[i].g, 1, "Green of pixel %d", i);
+        zassert_within(rgb_out[i].b, rgb_ref[i].b, 1, "Blue of pixel %d", i);
+    }
+
+    TC_PRINT("Gamma and brightness: table %.0f Mpx/s, powf %.0f Mpx/s\n", rate_mpps(integer_ns),
+             rate_mpps(float_ns));
+}
@@ -0,0 +1,16 @@
+/*
+ * Copyright (c) 2025 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+// Matches the driver API without CONFIG_LED_STRIP_RGB_SCRATCH.
+struct led_rgb {
+    uint8_t r;
+    uint8_t g;
+    uint8_t b;
+};
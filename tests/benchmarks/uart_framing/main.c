@@ -0,0 +1,149 @@
+/*
+ * Copyright (c) 2025 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+/*
+ * Throughput of the frame codecs on the host, with the figures quoted when COBS was added: frames
+ * of 256 random bytes, each encoded and decoded in one call. Wire sizes are averages over every
+ * frame, rates count payload bytes. The escape codec is also decoded the way it was before the
+ * bulk decoder, one uart_framing_process_byte() call per wire byte, as a baseline.
+ */
+
+#include <time.h>
+
+#include <zephyr/ztest.h>
+
+#include <uart_framing.h>
+
+#define FRAME_LEN 256
+// Few enough to stay in cache, as a frame on its way to the UART does.
+#define FRAME_COUNT 64
+#define REPEAT 1024
+// Escaping can double a frame, plus SOF and EOF.
+#define WIRE_MAX (2 * FRAME_LEN + 2)
+
+static uint8_t frames[FRAME_COUNT][FRAME_LEN];
+static uint8_t wire[FRAME_COUNT][WIRE_MAX];
+static size_t wire_lens[FRAME_COUNT];
+// One spare byte, so the decoder gets to the end of the frame, like the RX frame buffers.
+static uint8_t decoded[FRAME_LEN + 1];
+
+static uint64_t now_ns(void) {
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * NSEC_PER_SEC + ts.tv_nsec;
+}
+
+static double rate_mbps(uint64_t elapsed_ns) {
+    // Bytes per ns are GB/s.
+    return 1000.0 * FRAME_LEN * FRAME_COUNT * REPEAT / elapsed_ns;
+}
+
+static void *benchmark_setup(void) {
+    // xorshift32, so every run measures the same data.
+    uint32_t state = 0x2545F491;
+
+    for (int i = 0; i < FRAME_COUNT; i++) {
+        for (int j = 0; j < FRAME_LEN; j++) {
+            state ^= state << 13;
+            state ^= state >> 17;
+            state ^= state << 5;
+            frames[i][j] = state;
+        }
+    }
+
+    return NULL;
+}
+
+static uint64_t encode_frames(enum uart_framing_codec codec) {
+    struct uart_framing_encoder enc;
+    size_t consumed;
+    bool done;
+
+    const uint64_t start = now_ns();
+    for (int r = 0; r < REPEAT; r++) {
+        for (int i = 0; i < FRAME_COUNT; i++) {
+            uart_framing_encoder_init(&enc, codec);
+            size_t len = uart_framing_encode(&enc, frames[i], FRAME_LEN, &consumed, wire[i],
+                                             WIRE_MAX);
+            len += uart_framing_encode_end(&enc, &wire[i][len], WIRE_MAX - len, &done);
+            wire_lens[i] = len;
+        }
+    }
+
+    return now_ns() - start;
+}
+
+// Leaves the state of the last frame in dec, for the caller to check.
+static uint64_t decode_frames(struct uart_framing_decoder *dec, enum uart_framing_codec codec) {
+    size_t consumed;
+
+    const uint64_t start = now_ns();
+    for (int r = 0; r < REPEAT; r++) {
+        for (int i = 0; i < FRAME_COUNT; i++) {
+            uart_framing_decoder_init(dec, codec);
+            uart_framing_decode(dec, wire[i], wire_lens[i], &consumed, decoded, sizeof(decoded));
+        }
+    }
+
+    return now_ns() - start;
+}
+
+static void benchmark_codec(const char *name, enum uart_framing_codec codec) {
+    struct uart_framing_decoder dec;
+    size_t wire_total = 0;
+
+    const uint64_t encode_ns = encode_frames(codec);
+    for (int i = 0; i < FRAME_COUNT; i++) {
+        wire_total += wire_lens[i];
+    }
+    const uint64_t decode_ns = decode_frames(&dec, codec);
+
+    // The last frame of the last pass shows the timed calls did the whole job.
+    zassert_equal(dec.state, FRAMING_STATE_EOF);
+    zassert_mem_equal(decoded, frames[FRAME_COUNT - 1], FRAME_LEN);
+
+    TC_PRINT("%s: %zu wire bytes per %d byte frame, encode %.0f MB/s, decode %.0f MB/s\n", name,
+             wire_total / FRAME_COUNT, FRAME_LEN, rate_mbps(encode_ns), rate_mbps(decode_ns));
+}
+
+ZTEST_SUITE(uart_framing_benchmark, NULL, benchmark_setup, NULL, NULL, NULL);
+
+ZTEST(uart_framing_benchmark, test_escape) { benchmark_codec("escape", UART_FRAMING_CODEC_ESCAPE); }
+
+ZTEST(uart_framing_benchmark, test_cobs) { benchmark_codec("COBS", UART_FRAMING_CODEC_COBS); }
+
+ZTEST(uart_framing_benchmark, test_escape_per_byte) {
+    struct uart_framing_decoder dec;
+    enum uart_framing_state state;
+    size_t len;
+
+    encode_frames(UART_FRAMING_CODEC_ESCAPE);
+
+    const uint64_t start = now_ns();
+    for (int r = 0; r < REPEAT; r++) {
+        for (int i = 0; i < FRAME_COUNT; i++) {
+            state = FRAMING_STATE_IDLE;
+            len = 0;
+            for (size_t j = 0; j < wire_lens[i]; j++) {
+                if (uart_framing_process_byte(&state, wire[i][j]) && len < sizeof(decoded)) {
+                    decoded[len++] = wire[i][j];
+                }
+            }
+        }
+    }
+    const uint64_t per_byte_ns = now_ns() - start;
+
+    zassert_equal(state, FRAMING_STATE_EOF);
+    zassert_equal(len, FRAME_LEN);
+    zassert_mem_equal(decoded, frames[FRAME_COUNT - 1], FRAME_LEN);
+
+    const uint64_t decode_ns = decode_frames(&dec, UART_FRAMING_CODEC_ESCAPE);
+    zassert_equal(dec.state, FRAMING_STATE_EOF);
+
+    TC_PRINT("escape: decode %.0f MB/s per byte, %.0f MB/s with uart_framing_decode\n",
+             rate_mbps(per_byte_ns), rate_mbps(decode_ns));
+}
@@ -0,0 +1,190 @@
+/*
+ * Copyright (c) 2025 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <stdlib.h>
+
+#include <zephyr/ztest.h>
+
+#include <led_color.h>
+
+/*
+ * The references below are exact rationals. A value v stands for num / den rounded to nearest when
+ * |v * den - num| <= den / 2, checked doubled to stay in integers.
+ */
+static bool rounds_to(int64_t v, int64_t num, int64_t den) {
+    return llabs(2 * (v * den - num)) <= den;
+}
+
+ZTEST_SUITE(led_color, NULL, NULL, NULL, NULL, NULL);
+
+ZTEST(led_color, test_rgb_to_hsb_all_colors) {
+    for (int r = 0; r < 256; r++) {
+        for (int g = 0; g < 256; g++) {
+            for (int b = 0; b < 256; b++) {
+                const struct led_rgb rgb = {.r = r, .g = g, .b = b};
+                const struct zmk_led_hsb hsb = led_color_rgb_to_hsb(rgb);
+                const int max = MAX(r, MAX(g, b));
+                const int delta = max - MIN(r, MIN(g, b));
+
+                zassert_true(rounds_to(hsb.b, 100 * max, 255), "%d,%d,%d brightness %d", r, g, b,
+                             hsb.b);
+
+                if (delta == 0) {
+                    zassert_equal(hsb.s, 0, "%d,%d,%d is gray", r, g, b);
+                    zassert_equal(hsb.h, 0, "%d,%d,%d is gray", r, g, b);
+                    continue;
+                }
+
+                zassert_true(rounds_to(hsb.s, 100 * delta, max), "%d,%d,%d saturation %d", r, g,
+                             b, hsb.s);
+
+                // Hue times delta, between -60 and 300 degrees.
+                int hue;
+                if (max == r) {
+                    hue = 60 * (g - b);
+                } else if (max == g) {
+                    hue = 120 * delta + 60 * (b - r);
+                } else {
+                    hue = 240 * delta + 60 * (r - g);
+                }
+
+                zassert_true(hsb.h < LED_COLOR_HUE_MAX, "%d,%d,%d hue %d", r, g, b, hsb.h);
+                zassert_true(rounds_to(hsb.h, hue, delta) ||
+                                 rounds_to(hsb.h - LED_COLOR_HUE_MAX, hue, delta),
+                             "%d,%d,%d hue %d", r, g, b, hsb.h);
+            }
+        }
+    }
+}
+
+ZTEST(led_color, test_hsb_to_rgb_extremes) {
+    for (int h = 0; h < LED_COLOR_HUE_MAX; h++) {
+        for (int s = 0; s <= LED_COLOR_SAT_MAX; s++) {
+            for (int b = 0; b <= LED_COLOR_BRT_MAX; b++) {
+                const struct zmk_led_hsb hsb = {.h = h, .s = s, .b = b};
+                const struct led_rgb rgb = led_color_hsb_to_rgb(hsb);
+                const int max = MAX(rgb.r, MAX(rgb.g, rgb.b));
+                const int min = MIN(rgb.r, MIN(rgb.g, rgb.b));
+
+                // The strongest channel carries the brightness, the weakest the lack of color.
+                zassert_true(rounds_to(max, 255 * b, 100), "%d,%d,%d max %d", h, s, b, max);
+                zassert_true(rounds_to(min, 255 * b * (100 - s), 100 * 100), "%d,%d,%d min %d", h,
+                             s, b, min);
+            }
+        }
+    }
+}
+
+ZTEST(led_color, test_hsb_to_rgb_known_colors) {
+    const struct {
+        struct zmk_led_hsb hsb;
+        struct led_rgb rgb;
+    } colors[] = {
+        {{.h = 0, .s = 100, .b = 100}, {.r = 255, .g = 0, .b = 0}},
+        {{.h = 30, .s = 100, .b = 100}, {.r = 255, .g = 128, .b = 0}},
+        {{.h = 60, .s = 100, .b = 100}, {.r = 255, .g = 255, .b = 0}},
+        {{.h = 120, .s = 100, .b = 100}, {.r = 0, .g = 255, .b = 0}},
+        {{.h = 180, .s = 100, .b = 100}, {.r = 0, .g = 255, .b = 255}},
+        {{.h = 240, .s = 100, .b = 100}, {.r = 0, .g = 0, .b = 255}},
+        {{.h = 300, .s = 100, .b = 100}, {.r = 255, .g = 0, .b = 255}},
+        {{.h = 200, .s = 0, .b = 50}, {.r = 128, .g = 128, .b = 128}},
+        {{.h = 0, .s = 50, .b = 100}, {.r = 255, .g = 128, .b = 128}},
+        // Out of range values are clamped.
+        {{.h = 400, .s = 200, .b = 200}, {.r = 255, .g = 0, .b = 4}},
+    };
+
+    for (int i = 0; i < ARRAY_SIZE(colors); i++) {
+        const struct led_rgb rgb = led_color_hsb_to_rgb(colors[i].hsb);
+
+        zassert_equal(rgb.r, colors[i].rgb.r, "Color %d red %d", i, rgb.r);
+        zassert_equal(rgb.g, colors[i].rgb.g, "Color %d green %d", i, rgb.g);
+        zassert_equal(rgb.b, colors[i].rgb.b, "Color %d blue %d", i, rgb.b);
+    }
+}
+
+ZTEST(led_color, test_buffers_match_single_conversions) {
+    struct led_rgb rgb[64];
+    struct zmk_led_hsb hsb[ARRAY_SIZE(rgb)];
+    struct led_rgb back[ARRAY_SIZE(rgb)];
+
+    for (int i = 0; i < ARRAY_SIZE(rgb); i++) {
+        rgb[i] = (struct led_rgb){.r = i * 4, .g = 255 - i * 3, .b = (i * 37) & 0xFF};
+    }
+
+    led_color_rgb_to_hsb_buf(rgb, hsb, ARRAY_SIZE(rgb));
+    led_color_hsb_to_rgb_buf(hsb, back, ARRAY_SIZE(rgb));
+
+    for (int i = 0; i < ARRAY_SIZE(rgb); i++) {
+        const struct zmk_led_hsb single = led_color_rgb_to_hsb(rgb[i]);
+        const struct led_rgb single_back = led_color_hsb_to_rgb(single);
+
+        zassert_true(hsb[i].h == single.h && hsb[i].s == single.s && hsb[i].b == single.b,
+                     "Pixel %d", i);
+        zassert_true(back[i].r == single_back.r && back[i].g == single_back.g &&
+                         back[i].b == single_back.b,
+                     "Pixel %d", i);
+    }
+}
+
+ZTEST(led_color, test_scale8_all_pairs) {
+    for (int value = 0; value < 256; value++) {
+        for (int scale = 0; scale < 256; scale++) {
+            zassert_true(rounds_to(led_color_scale8(value, scale), value * scale, 255),
+                         "%d * %d / 255", value, scale);
+        }
+    }
+}
+
+ZTEST(led_color, test_hsb_lerp) {
+    const struct zmk_led_hsb from = {.h = 350, .s = 20, .b = 100};
+    const struct zmk_led_hsb to = {.h = 10, .s = 80, .b = 0};
+
+    const struct zmk_led_hsb start = led_color_hsb_lerp(from, to, 0);
+    zassert_true(start.h == from.h && start.s == from.s && start.b == from.b);
+
+    const struct zmk_led_hsb end = led_color_hsb_lerp(from, to, 1 << 16);
+    zassert_true(end.h == to.h && end.s == to.s && end.b == to.b);
+
+    // Past the end stays at the end.
+    const struct zmk_led_hsb past = led_color_hsb_lerp(from, to, 1 << 17);
+    zassert_true(past.h == to.h && past.s == to.s && past.b == to.b);
+
+    // Hue takes the short way, across 0 rather than through 180.
+    const struct zmk_led_hsb middle = led_color_hsb_lerp(from, to, 1 << 15);
+    zassert_equal(middle.h, 0);
+    zassert_equal(middle.s, 50);
+    zassert_equal(middle.b, 50);
+
+    const struct zmk_led_hsb back = led_color_hsb_lerp(to, from, 1 << 14);
+    zassert_equal(back.h, 5);
+}
+
+ZTEST(led_color, test_lut) {
+    uint8_t lut[256];
+
+    led_color_lut_build(lut, false, 255);
+    for (int i = 0; i < 256; i++) {
+        zassert_equal(lut[i], i, "Identity at %d", i);
+    }
+
+    led_color_lut_build(lut, false, 128);
+    for (int i = 0; i < 256; i++) {
+        zassert_equal(lut[i], led_color_scale8(i, 128), "Scaled at %d", i);
+    }
+
+    led_color_lut_build(lut, true, 255);
+    zassert_equal(lut[0], 0);
+    zassert_equal(lut[128], 56);
+    zassert_equal(lut[255], 255);
+    for (int i = 1; i < 256; i++) {
+        zassert_true(lut[i] >= lut[i - 1], "Gamma falls at %d", i);
+    }
+
+    struct led_rgb pixels[] = {{.r = 0, .g = 128, .b = 255}, {.r = 255, .g = 0, .b = 128}};
+    led_color_lut_apply(lut, pixels, ARRAY_SIZE(pixels));
+    zassert_true(pixels[0].r == 0 && pixels[0].g == 56 && pixels[0].b == 255);
+    zassert_true(pixels[1].r == 255 && pixels[1].g == 0 && pixels[1].b == 56);
+}
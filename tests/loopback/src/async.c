@@ -0,0 +1,129 @@
+/*
+ * Copyright (c) 2025 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+/*
+ * An asynchronous handler that waits for the test to let it finish, standing in for
+ * keymap.read_bindings, so requests can be held pending while others are handled.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/ztest.h>
+
+#include "host.h"
+
+LOG_MODULE_DECLARE(bridge_loopback_test, LOG_LEVEL_INF);
+
+static struct host host;
+
+// Given once for every handler call the test lets finish.
+static K_SEM_DEFINE(read_bindings_gate, 0, CONFIG_ZMK_BRIDGE_ASYNC_MAX_PENDING);
+static atomic_t read_bindings_calls;
+
+static void read_bindings(const bridge_Request *req, struct bridge_completion *completion) {
+    const bridge_keymap_BindingRange *range = &req->subsystem.keymap.request_type.read_bindings;
+
+    atomic_inc(&read_bindings_calls);
+    k_sem_take(&read_bindings_gate, K_FOREVER);
+
+    // Echoes the range, which the handler reads from its copy of the request.
+    const bridge_keymap_Bindings bindings = {.layer = range->layer, .start = range->start};
+    const bridge_Response resp = BRIDGE_RESPONSE(keymap, read_bindings, bindings);
+    bridge_complete(completion, &resp);
+}
+
+BRIDGE_SUBSYSTEM_HANDLER_ASYNC(keymap, read_bindings);
+
+static bridge_Request read_bindings_request(uint32_t request_id, uint32_t layer) {
+    bridge_Request req = bridge_Request_init_zero;
+
+    req.request_id = request_id;
+    req.which_subsystem = bridge_Request_keymap_tag;
+    req.subsystem.keymap.which_request_type = bridge_keymap_Request_read_bindings_tag;
+    req.subsystem.keymap.request_type.read_bindings.layer = layer;
+    req.subsystem.keymap.request_type.read_bindings.start = request_id;
+    return req;
+}
+
+static void expect_read_bindings(uint32_t request_id, uint32_t layer) {
+    bridge_Response resp;
+
+    zassert_true(host_receive(&host, &resp));
+    zassert_equal(resp.request_id, request_id);
+    zassert_true(resp.request_status);
+    zassert_equal(resp.which_subsystem, bridge_Response_keymap_tag);
+    zassert_equal(resp.subsystem.keymap.which_response_type,
+                  bridge_keymap_Response_read_bindings_tag);
+    zassert_equal(resp.subsystem.keymap.response_type.read_bindings.layer, layer);
+    zassert_equal(resp.subsystem.keymap.response_type.read_bindings.start, request_id);
+}
+
+static void async_before(void *fixture) {
+    host_init(&host, 0);
+    host_drain(&host, K_MSEC(10));
+    k_sem_reset(&read_bindings_gate);
+    atomic_clear(&read_bindings_calls);
+}
+
+ZTEST_SUITE(bridge_async, NULL, NULL, async_before, NULL, NULL);
+
+ZTEST(bridge_async, test_out_of_order) {
+    bridge_Response resp;
+    bridge_Request req = read_bindings_request(900, 1);
+
+    zassert_true(host_send(&host, &req));
+
+    // Answered while the async request is still pending.
+    req = (bridge_Request)bridge_Request_init_zero;
+    req.request_id = 901;
+    req.get_bridge_info = true;
+    zassert_true(host_send(&host, &req));
+    zassert_true(host_receive(&host, &resp));
+    zassert_equal(resp.request_id, 901);
+    zassert_true(resp.has_bridge_info);
+
+    k_sem_give(&read_bindings_gate);
+    expect_read_bindings(900, 1);
+    zassert_equal(atomic_get(&read_bindings_calls), 1);
+}
+
+ZTEST(bridge_async, test_max_pending) {
+    bridge_Response resp;
+
+    for (int i = 0; i <= CONFIG_ZMK_BRIDGE_ASYNC_MAX_PENDING; i++) {
+        const bridge_Request req = read_bindings_request(910 + i, i);
+        zassert_true(host_send(&host, &req));
+    }
+
+    // No completion token left for the last one, it fails without waiting for the others.
+    zassert_true(host_receive(&host, &resp));
+    zassert_equal(resp.request_id, 910 + CONFIG_ZMK_BRIDGE_ASYNC_MAX_PENDING);
+    zassert_false(resp.request_status);
+
+    // The handler takes them one at a time, in order.
+    for (int i = 0; i < CONFIG_ZMK_BRIDGE_ASYNC_MAX_PENDING; i++) {
+        k_sem_give(&read_bindings_gate);
+        expect_read_bindings(910 + i, i);
+    }
+
+    zassert_equal(atomic_get(&read_bindings_calls), CONFIG_ZMK_BRIDGE_ASYNC_MAX_PENDING);
+}
+
+ZTEST(bridge_async, test_not_batched) {
+    bridge_Response resp;
+    const bridge_Request items[] = {device_info_request(0), read_bindings_request(0, 0)};
+    const struct batch_items batch = {items, ARRAY_SIZE(items)};
+
+    const bridge_Request req = batch_request(920, &batch, false);
+    zassert_true(host_send(&host, &req));
+    zassert_true(host_receive(&host, &resp));
+    zassert_equal(resp.request_id, 920);
+    zassert_false(resp.request_status);
+    zassert_equal(resp.batch.executed, 2);
+    zassert_equal(resp.batch.status_bitmap, 0b01);
+
+    zassert_equal(atomic_get(&read_bindings_calls), 0);
+}
@@ -0,0 +1,163 @@
+/*
+ * Copyright (c) 2025 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+/*
+ * Chunked reads of a blob registered by the test, checking where each window starts and stops and
+ * that every chunk carries the right bytes.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+#include <pb_decode.h>
+
+#include "host.h"
+
+// The first id left to modules.
+#define TEST_BLOB_ID 256
+// More than a window of the largest chunks, and not a multiple of the chunk sizes used.
+#define TEST_BLOB_SIZE                                                                             \
+    (CONFIG_ZMK_BRIDGE_CHUNK_MAX_SIZE * CONFIG_ZMK_BRIDGE_CHUNK_MAX_WINDOW + 476)
+
+static struct host host;
+
+static uint8_t blob_byte(size_t offset) { return (offset ^ (offset >> 8)) & 0xff; }
+
+static size_t test_blob_size(void) { return TEST_BLOB_SIZE; }
+
+static int test_blob_read(size_t offset, uint8_t *buf, size_t len) {
+    for (size_t i = 0; i < len; i++) {
+        buf[i] = blob_byte(offset + i);
+    }
+
+    return 0;
+}
+
+BRIDGE_BLOB_PROVIDER(test_blob, TEST_BLOB_ID, test_blob_size, test_blob_read);
+
+struct received_chunk {
+    uint8_t data[CONFIG_ZMK_BRIDGE_CHUNK_MAX_SIZE];
+    size_t len;
+};
+
+static bool decode_chunk_data(pb_istream_t *stream, const pb_field_t *field, void **arg) {
+    struct received_chunk *chunk = *arg;
+
+    chunk->len = stream->bytes_left;
+    return chunk->len <= sizeof(chunk->data) && pb_read(stream, chunk->data, chunk->len);
+}
+
+static void read_chunks(uint32_t request_id, uint32_t blob_id, uint32_t offset,
+                        uint32_t chunk_size, uint32_t window) {
+    bridge_Request req = bridge_Request_init_zero;
+
+    req.request_id = request_id;
+    req.has_read_chunks = true;
+    req.read_chunks.blob_id = blob_id;
+    req.read_chunks.offset = offset;
+    req.read_chunks.chunk_size = chunk_size;
+    req.read_chunks.window = window;
+    zassert_true(host_send(&host, &req));
+}
+
+static void expect_chunk(uint32_t request_id, uint32_t offset, size_t len) {
+    struct received_chunk chunk = {0};
+    bridge_Response resp = bridge_Response_init_zero;
+
+    resp.chunk.data.funcs.decode = decode_chunk_data;
+    resp.chunk.data.arg = &chunk;
+    zassert_true(host_receive_frame(&host, &resp, HOST_TIMEOUT), "No chunk at %d", offset);
+    zassert_equal(resp.request_id, request_id);
+    zassert_true(resp.request_status);
+    zassert_true(resp.has_chunk);
+    zassert_equal(resp.chunk.blob_id, TEST_BLOB_ID);
+    zassert_equal(resp.chunk.offset, offset);
+    zassert_equal(resp.chunk.total_size, TEST_BLOB_SIZE);
+    zassert_equal(chunk.len, len, "Chunk at %d", offset);
+
+    for (size_t i = 0; i < chunk.len; i++) {
+        zassert_equal(chunk.data[i], blob_byte(offset + i), "Byte %d", (int)(offset + i));
+    }
+}
+
+// The window ended, nothing else answers the request.
+static void expect_window_end(void) {
+    bridge_Response resp = bridge_Response_init_zero;
+
+    zassert_false(host_receive_frame(&host, &resp, K_MSEC(50)), "More than a window of chunks");
+}
+
+static void chunks_before(void *fixture) {
+    host_init(&host, 0);
+    host_drain(&host, K_MSEC(10));
+}
+
+ZTEST_SUITE(bridge_chunks, NULL, NULL, chunks_before, NULL, NULL);
+
+ZTEST(bridge_chunks, test_window) {
+    read_chunks(700, TEST_BLOB_ID, 0, 100, 3);
+    for (int i = 0; i < 3; i++) {
+        expect_chunk(700, i * 100, 100);
+    }
+    expect_window_end();
+
+    // The host picks up where the window ended.
+    read_chunks(701, TEST_BLOB_ID, 300, 100, 2);
+    expect_chunk(701, 300, 100);
+    expect_chunk(701, 400, 100);
+    expect_window_end();
+}
+
+ZTEST(bridge_chunks, test_device_maximum) {
+    // 0 asks for the device maximum, as does anything above it.
+    read_chunks(710, TEST_BLOB_ID, 0, 0, 0);
+    for (int i = 0; i < CONFIG_ZMK_BRIDGE_CHUNK_MAX_WINDOW; i++) {
+        expect_chunk(710, i * CONFIG_ZMK_BRIDGE_CHUNK_MAX_SIZE, CONFIG_ZMK_BRIDGE_CHUNK_MAX_SIZE);
+    }
+    expect_window_end();
+
+    read_chunks(711, TEST_BLOB_ID, 0, CONFIG_ZMK_BRIDGE_CHUNK_MAX_SIZE + 1,
+                CONFIG_ZMK_BRIDGE_CHUNK_MAX_WINDOW + 1);
+    for (int i = 0; i < CONFIG_ZMK_BRIDGE_CHUNK_MAX_WINDOW; i++) {
+        expect_chunk(711, i * CONFIG_ZMK_BRIDGE_CHUNK_MAX_SIZE, CONFIG_ZMK_BRIDGE_CHUNK_MAX_SIZE);
+    }
+    expect_window_end();
+}
+
+ZTEST(bridge_chunks, test_last_chunk) {
+    // The last chunk is short, and the window stops with it.
+    read_chunks(720, TEST_BLOB_ID, TEST_BLOB_SIZE - 150, 100, 4);
+    expect_chunk(720, TEST_BLOB_SIZE - 150, 100);
+    expect_chunk(720, TEST_BLOB_SIZE - 50, 50);
+    expect_window_end();
+
+    // Ending right at the end of the blob does not add an empty chunk.
+    read_chunks(721, TEST_BLOB_ID, TEST_BLOB_SIZE - 200, 100, 4);
+    expect_chunk(721, TEST_BLOB_SIZE - 200, 100);
+    expect_chunk(721, TEST_BLOB_SIZE - 100, 100);
+    expect_window_end();
+}
+
+ZTEST(bridge_chunks, test_offset_past_end) {
+    // One empty chunk, which still tells the host the size of the blob.
+    read_chunks(730, TEST_BLOB_ID, TEST_BLOB_SIZE, 100, 4);
+    expect_chunk(730, TEST_BLOB_SIZE, 0);
+    expect_window_end();
+
+    read_chunks(731, TEST_BLOB_ID, TEST_BLOB_SIZE + 1000, 100, 4);
+    expect_chunk(731, TEST_BLOB_SIZE + 1000, 0);
+    expect_window_end();
+}
+
+ZTEST(bridge_chunks, test_unknown_blob) {
+    bridge_Response resp;
+
+    read_chunks(740, TEST_BLOB_ID + 1, 0, 100, 4);
+    zassert_true(host_receive(&host, &resp));
+    zassert_equal(resp.request_id, 740);
+    zassert_false(resp.request_status);
+    zassert_false(resp.has_chunk);
+    expect_window_end();
+}
@@ -0,0 +1,293 @@
+/*
+ * Copyright (c) 2025 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+/*
+ * Position, layer and keycode events raised through ZMK's event manager, as the keymap would raise
+ * them, and the EventBatch notifications the host gets for them.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/ztest.h>
+#include <pb_decode.h>
+
+#include <dt-bindings/zmk/hid_usage_pages.h>
+#include <zmk/events/keycode_state_changed.h>
+#include <zmk/events/layer_state_changed.h>
+#include <zmk/events/position_state_changed.h>
+
+#include "host.h"
+
+// The event manager is built from ZMK's sources, which log to ZMK's module.
+LOG_MODULE_REGISTER(zmk, CONFIG_ZMK_LOG_LEVEL);
+
+#define RING_SIZE CONFIG_ZMK_BRIDGE_EVENTS_RING_SIZE
+#define BATCH_SIZE CONFIG_ZMK_BRIDGE_EVENTS_BATCH_SIZE
+#define FULL_RING_BATCHES DIV_ROUND_UP(RING_SIZE, BATCH_SIZE)
+
+BUILD_ASSERT(FULL_RING_BATCHES <= CONFIG_ZMK_BRIDGE_NOTIFICATION_LOW_QUEUE_SIZE,
+             "The batches of a full ring have to fit in the notification queue");
+
+#define POSITION bridge_events_EventType_EVENT_TYPE_POSITION
+#define LAYER bridge_events_EventType_EVENT_TYPE_LAYER
+#define KEYBOARD bridge_events_EventType_EVENT_TYPE_KEYBOARD
+#define CONSUMER bridge_events_EventType_EVENT_TYPE_CONSUMER
+
+static struct host host;
+
+struct received_batch {
+    uint32_t base_time_ms;
+    uint32_t dropped;
+    uint32_t events[BATCH_SIZE];
+    size_t len;
+};
+
+static bool decode_batch_event(pb_istream_t *stream, const pb_field_t *field, void **arg) {
+    struct received_batch *batch = *arg;
+
+    return batch->len < ARRAY_SIZE(batch->events) &&
+           pb_decode_fixed32(stream, &batch->events[batch->len++]);
+}
+
+static void receive_batch(struct received_batch *batch) {
+    const uint32_t path[] = {bridge_Response_notification_tag, bridge_Notification_events_tag,
+                             bridge_events_Notification_batch_tag};
+    bridge_events_EventBatch event_batch = bridge_events_EventBatch_init_zero;
+    bridge_Response resp = bridge_Response_init_zero;
+
+    zassert_true(host_receive_frame(&host, &resp, HOST_TIMEOUT), "No event batch");
+    zassert_true(resp.has_notification);
+    zassert_equal(resp.notification.which_subsystem, bridge_Notification_events_tag);
+
+    // The events are in a callback field of a oneof, which the response left out.
+    *batch = (struct received_batch){0};
+    event_batch.events.funcs.decode = decode_batch_event;
+    event_batch.events.arg = batch;
+    zassert_true(host_decode_nested(&host, path, ARRAY_SIZE(path),
+                                    bridge_events_EventBatch_fields, &event_batch));
+    batch->base_time_ms = event_batch.base_time_ms;
+    batch->dropped = event_batch.dropped;
+}
+
+// Unpacks an event, see events.EventBatch.
+static void expect_event(uint32_t event, bridge_events_EventType type, uint16_t value,
+                         bool state) {
+    zassert_equal(event & BIT_MASK(3), type, "Event 0x%08x", event);
+    zassert_equal((event & BIT(3)) != 0, state, "Event 0x%08x", event);
+    zassert_equal((event >> 4) & BIT_MASK(16), value, "Event 0x%08x", event);
+}
+
+// Longer than an event waits for its batch to fill up.
+static void expect_no_batch(void) {
+    bridge_Response resp = bridge_Response_init_zero;
+
+    zassert_false(host_receive_frame(&host, &resp,
+                                     K_MSEC(CONFIG_ZMK_BRIDGE_EVENTS_FLUSH_DEADLINE_MS + 50)),
+                  "Unexpected event batch");
+}
+
+static bridge_Request events_request(pb_size_t request_type) {
+    bridge_Request req = bridge_Request_init_zero;
+
+    req.request_id = 2100 + request_type;
+    req.which_subsystem = bridge_Request_events_tag;
+    req.subsystem.events.which_request_type = request_type;
+    return req;
+}
+
+static void subscribe(uint32_t filter) {
+    bridge_Request req = events_request(bridge_events_Request_subscribe_tag);
+    bridge_Response resp;
+
+    req.subsystem.events.request_type.subscribe.filter = filter;
+    zassert_true(host_send(&host, &req));
+    zassert_true(host_receive(&host, &resp));
+    zassert_true(resp.request_status);
+}
+
+static void events_stats(bridge_events_Stats *stats) {
+    bridge_Request req = events_request(bridge_events_Request_get_stats_tag);
+    bridge_Response resp;
+
+    req.subsystem.events.request_type.get_stats = true;
+    zassert_true(host_send(&host, &req));
+    zassert_true(host_receive(&host, &resp));
+    zassert_true(resp.request_status);
+    zassert_equal(resp.subsystem.events.which_response_type, bridge_events_Response_get_stats_tag);
+    *stats = resp.subsystem.events.response_type.get_stats;
+}
+
+static void press(uint32_t position, bool pressed) {
+    raise_zmk_position_state_changed((struct zmk_position_state_changed){
+        .source = ZMK_POSITION_STATE_CHANGE_SOURCE_LOCAL,
+        .position = position,
+        .state = pressed,
+        .timestamp = k_uptime_get(),
+    });
+}
+
+// One event of every type the subsystem streams.
+static void raise_every_type(void) {
+    press(3, true);
+    raise_zmk_layer_state_changed((struct zmk_layer_state_changed){
+        .layer = 1,
+        .state = true,
+        .timestamp = k_uptime_get(),
+    });
+    raise_zmk_keycode_state_changed((struct zmk_keycode_state_changed){
+        .usage_page = HID_USAGE_KEY,
+        .keycode = 0x04,
+        .state = true,
+        .timestamp = k_uptime_get(),
+    });
+    raise_zmk_keycode_state_changed((struct zmk_keycode_state_changed){
+        .usage_page = HID_USAGE_CONSUMER,
+        .keycode = 0xe9,
+        .state = false,
+        .timestamp = k_uptime_get(),
+    });
+}
+
+static void events_before(void *fixture) {
+    bridge_Request req = events_request(bridge_events_Request_reset_stats_tag);
+    bridge_Response resp;
+
+    host_init(&host, 0);
+    host_drain(&host, K_MSEC(10));
+
+    req.subsystem.events.request_type.reset_stats = true;
+    zassert_true(host_send(&host, &req));
+    zassert_true(host_receive(&host, &resp));
+    zassert_true(resp.request_status);
+}
+
+// The batches went to every session, the second one has to be read too.
+static void events_after(void *fixture) {
+    struct host other;
+
+    subscribe(0);
+    host_init(&other, 1);
+    host_drain(&other, K_MSEC(10));
+}
+
+ZTEST_SUITE(bridge_events, NULL, NULL, events_before, events_after, NULL);
+
+ZTEST(bridge_events, test_batches) {
+    struct received_batch batch;
+    bridge_events_Stats stats;
+
+    subscribe(BIT(POSITION));
+    for (int i = 0; i < BATCH_SIZE + 2; i++) {
+        press(i, i % 2 == 0);
+    }
+
+    // A full batch goes out right away, the rest once they waited long enough.
+    receive_batch(&batch);
+    zassert_equal(batch.len, BATCH_SIZE);
+    zassert_equal(batch.dropped, 0);
+    for (int i = 0; i < BATCH_SIZE; i++) {
+        expect_event(batch.events[i], POSITION, i, i % 2 == 0);
+    }
+
+    receive_batch(&batch);
+    zassert_equal(batch.len, 2);
+    expect_event(batch.events[0], POSITION, BATCH_SIZE, BATCH_SIZE % 2 == 0);
+    expect_event(batch.events[1], POSITION, BATCH_SIZE + 1, BATCH_SIZE % 2 != 0);
+    expect_no_batch();
+
+    events_stats(&stats);
+    zassert_equal(stats.events, BATCH_SIZE + 2);
+    zassert_equal(stats.batches, 2);
+    zassert_equal(stats.batches_dropped, 0);
+}
+
+ZTEST(bridge_events, test_flush_deadline) {
+    struct received_batch batch;
+
+    subscribe(BIT(POSITION));
+    const int64_t start = k_uptime_get();
+    press(7, true);
+
+    receive_batch(&batch);
+    const int64_t elapsed = k_uptime_get() - start;
+    zassert_true(elapsed >= CONFIG_ZMK_BRIDGE_EVENTS_FLUSH_DEADLINE_MS, "Sent after %d ms",
+                 (int)elapsed);
+    zassert_true(batch.base_time_ms - (uint32_t)start <= 1);
+    zassert_equal(batch.len, 1);
+    expect_event(batch.events[0], POSITION, 7, true);
+}
+
+ZTEST(bridge_events, test_event_types) {
+    struct received_batch batch;
+
+    subscribe(BIT_MASK(4));
+    raise_every_type();
+
+    receive_batch(&batch);
+    zassert_equal(batch.len, 4);
+    expect_event(batch.events[0], POSITION, 3, true);
+    expect_event(batch.events[1], LAYER, 1, true);
+    expect_event(batch.events[2], KEYBOARD, 0x04, true);
+    expect_event(batch.events[3], CONSUMER, 0xe9, false);
+}
+
+ZTEST(bridge_events, test_filter) {
+    struct received_batch batch;
+    bridge_events_Stats stats;
+
+    subscribe(BIT(KEYBOARD));
+    raise_every_type();
+    receive_batch(&batch);
+    zassert_equal(batch.len, 1);
+    expect_event(batch.events[0], KEYBOARD, 0x04, true);
+
+    // A filter of 0 stops the stream.
+    subscribe(0);
+    raise_every_type();
+    expect_no_batch();
+
+    // Events left out by the filter are not counted as dropped.
+    events_stats(&stats);
+    zassert_equal(stats.events, 1);
+    for (int i = 0; i < stats.dropped_count; i++) {
+        zassert_equal(stats.dropped[i], 0);
+    }
+}
+
+ZTEST(bridge_events, test_ring_full) {
+    struct received_batch batch;
+    bridge_events_Stats stats;
+    uint32_t received = 0;
+
+    subscribe(BIT(POSITION));
+
+    // Nothing is flushed while the scheduler is locked, the events past the ring are dropped.
+    k_sched_lock();
+    for (int i = 0; i < RING_SIZE + 5; i++) {
+        press(i, true);
+    }
+    k_sched_unlock();
+
+    for (int i = 0; i < FULL_RING_BATCHES; i++) {
+        receive_batch(&batch);
+        zassert_equal(batch.len, MIN(RING_SIZE - received, BATCH_SIZE));
+        // Reported with the batch after the drop, once.
+        zassert_equal(batch.dropped, i == 0 ? 5 : 0);
+        for (int j = 0; j < batch.len; j++) {
+            expect_event(batch.events[j], POSITION, received + j, true);
+        }
+        received += batch.len;
+    }
+    expect_no_batch();
+
+    events_stats(&stats);
+    zassert_equal(stats.dropped_count, 4);
+    zassert_equal(stats.dropped[POSITION], 5);
+    zassert_equal(stats.dropped[LAYER], 0);
+    zassert_equal(stats.events, RING_SIZE);
+    zassert_equal(stats.batches, FULL_RING_BATCHES);
+    zassert_equal(stats.batches_dropped, 0);
+}
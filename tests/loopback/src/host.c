@@ -0,0 +1,291 @@
+/*
+ * Copyright (c) 2025 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <zephyr/ztest.h>
+#include <pb_decode.h>
+
+#include <zmk/bridge_loopback.h>
+
+#include "host.h"
+
+void host_init(struct host *host, uint8_t session) {
+    host->session = session;
+    host->wire_len = 0;
+    host->wire_pos = 0;
+    uart_framing_decoder_init(&host->dec, UART_FRAMING_CODEC_ESCAPE);
+}
+
+size_t host_encode(const bridge_Request *req, uint8_t *frame, size_t size) {
+    pb_ostream_t stream = pb_ostream_from_buffer(frame, size - UART_FRAMING_CHECK_LEN);
+
+    if (!pb_encode(&stream, bridge_Request_fields, req)) {
+        return 0;
+    }
+
+    const size_t len = stream.bytes_written;
+    uart_framing_check_put(uart_framing_check_update(uart_framing_check_init(), frame, len),
+                           &frame[len]);
+    return len + UART_FRAMING_CHECK_LEN;
+}
+
+bool host_send_wire(const struct host *host, const uint8_t *wire, size_t len) {
+    return len == 0 || bridge_loopback_send(host->session, wire, len, HOST_TIMEOUT) == 0;
+}
+
+bool host_send_frame(const struct host *host, const uint8_t *frame, size_t len) {
+    struct uart_framing_encoder enc;
+    uint8_t wire[64];
+    bool done = false;
+
+    uart_framing_encoder_init(&enc, UART_FRAMING_CODEC_ESCAPE);
+    while (len > 0) {
+        size_t consumed;
+        const size_t wire_len =
+            uart_framing_encode(&enc, frame, len, &consumed, wire, sizeof(wire));
+        frame += consumed;
+        len -= consumed;
+
+        if (!host_send_wire(host, wire, wire_len)) {
+            return false;
+        }
+    }
+
+    while (!done) {
+        const size_t wire_len = uart_framing_encode_end(&enc, wire, sizeof(wire), &done);
+        if (!host_send_wire(host, wire, wire_len)) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool host_send(const struct host *host, const bridge_Request *req) {
+    uint8_t frame[CONFIG_ZMK_BRIDGE_RX_FRAME_SIZE];
+    const size_t len = host_encode(req, frame, sizeof(frame));
+
+    if (len == 0) {
+        TC_PRINT("Session %d: request does not encode\n", host->session);
+        return false;
+    }
+
+    return host_send_frame(host, frame, len);
+}
+
+bool host_receive_frame(struct host *host, bridge_Response *resp, k_timeout_t timeout) {
+    size_t len = 0;
+
+    for (;;) {
+        if (host->wire_pos == host->wire_len) {
+            host->wire_len =
+                bridge_loopback_receive(host->session, host->wire, sizeof(host->wire), timeout);
+            host->wire_pos = 0;
+            if (host->wire_len == 0) {
+                return false;
+            }
+        }
+
+        size_t consumed;
+        len += uart_framing_decode(&host->dec, &host->wire[host->wire_pos],
+                                   host->wire_len - host->wire_pos, &consumed, &host->frame[len],
+                                   sizeof(host->frame) - len);
+        host->wire_pos += consumed;
+
+        if (host->dec.state == FRAMING_STATE_ERR || len == sizeof(host->frame)) {
+            TC_PRINT("Session %d: broken frame\n", host->session);
+            uart_framing_decoder_init(&host->dec, UART_FRAMING_CODEC_ESCAPE);
+            return false;
+        }
+
+        if (host->dec.state == FRAMING_STATE_EOF) {
+            break;
+        }
+    }
+
+    uart_framing_decoder_init(&host->dec, UART_FRAMING_CODEC_ESCAPE);
+    if (!uart_framing_check_frame(host->frame, len)) {
+        TC_PRINT("Session %d: frame fails its check\n", host->session);
+        return false;
+    }
+
+    host->frame_len = len - UART_FRAMING_CHECK_LEN;
+    pb_istream_t stream = pb_istream_from_buffer(host->frame, host->frame_len);
+    if (!pb_decode(&stream, bridge_Response_fields, resp)) {
+        TC_PRINT("Session %d: frame does not decode\n", host->session);
+        return false;
+    }
+
+    return true;
+}
+
+bool host_receive(struct host *host, bridge_Response *resp) {
+    do {
+        *resp = (bridge_Response)bridge_Response_init_zero;
+        if (!host_receive_frame(host, resp, HOST_TIMEOUT)) {
+            TC_PRINT("Session %d: no response\n", host->session);
+            return false;
+        }
+    } while (resp->has_notification);
+
+    return true;
+}
+
+void host_drain(struct host *host, k_timeout_t quiet) {
+    bridge_Response resp;
+
+    do {
+        resp = (bridge_Response)bridge_Response_init_zero;
+    } while (host_receive_frame(host, &resp, quiet));
+}
+
+static bool find_submessage(pb_istream_t *stream, uint32_t tag, pb_istream_t *substream) {
+    pb_wire_type_t wire_type;
+    uint32_t field_tag;
+    bool eof;
+
+    while (pb_decode_tag(stream, &wire_type, &field_tag, &eof)) {
+        if (field_tag == tag && wire_type == PB_WT_STRING) {
+            return pb_make_string_substream(stream, substream);
+        }
+
+        if (!pb_skip_field(stream, wire_type)) {
+            return false;
+        }
+    }
+
+    return false;
+}
+
+bool host_decode_nested(const struct host *host, const uint32_t *path, size_t depth,
+                        const pb_msgdesc_t *fields, void *dest) {
+    pb_istream_t stream = pb_istream_from_buffer(host->frame, host->frame_len);
+
+    for (size_t i = 0; i < depth; i++) {
+        pb_istream_t substream;
+
+        if (!find_submessage(&stream, path[i], &substream)) {
+            return false;
+        }
+
+        stream = substream;
+    }
+
+    return pb_decode(&stream, fields, dest);
+}
+
+bridge_Request device_info_request(uint32_t request_id) {
+    bridge_Request req = bridge_Request_init_zero;
+
+    req.request_id = request_id;
+    req.which_subsystem = bridge_Request_core_tag;
+    req.subsystem.core.which_request_type = bridge_core_Request_get_device_info_tag;
+    req.subsystem.core.request_type.get_device_info = true;
+    return req;
+}
+
+static bool encode_values_raw(pb_ostream_t *stream, const struct values *values) {
+    for (size_t i = 0; i < values->len; i++) {
+        if (!pb_encode_varint(stream, values->values[i])) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool host_encode_values(pb_ostream_t *stream, const pb_field_t *field, void *const *arg) {
+    const struct values *values = *arg;
+    pb_ostream_t sizing = PB_OSTREAM_SIZING;
+
+    return encode_values_raw(&sizing, values) && pb_encode_tag(stream, PB_WT_STRING, field->tag) &&
+           pb_encode_varint(stream, sizing.bytes_written) && encode_values_raw(stream, values);
+}
+
+static bool encode_batch_items(pb_ostream_t *stream, const pb_field_t *field, void *const *arg) {
+    const struct batch_items *items = *arg;
+
+    for (size_t i = 0; i < items->len; i++) {
+        if (!pb_encode_tag_for_field(stream, field) ||
+            !pb_encode_submessage(stream, bridge_Request_fields, &items->requests[i])) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bridge_Request batch_request(uint32_t request_id, const struct batch_items *items,
+                             bool stop_on_failure) {
+    bridge_Request req = bridge_Request_init_zero;
+
+    req.request_id = request_id;
+    req.has_batch = true;
+    req.batch.requests.funcs.encode = encode_batch_items;
+    req.batch.requests.arg = (void *)items;
+    req.batch.stop_on_failure = stop_on_failure;
+    return req;
+}
+
+#if IS_ENABLED(CONFIG_ZMK_BRIDGE_LATENCY_STATS)
+bool host_reset_latency_stats(struct host *host) {
+    bridge_Request req = bridge_Request_init_zero;
+    bridge_Response resp;
+
+    req.which_subsystem = bridge_Request_core_tag;
+    req.subsystem.core.which_request_type = bridge_core_Request_reset_latency_stats_tag;
+    req.subsystem.core.request_type.reset_latency_stats = true;
+
+    return host_send(host, &req) && host_receive(host, &resp) && resp.request_status;
+}
+
+struct command_lookup {
+    uint32_t subsystem;
+    uint32_t request;
+    bridge_core_CommandLatency *latency;
+};
+
+static bool find_command_latency(pb_istream_t *stream, const pb_field_t *field, void **arg) {
+    struct command_lookup *lookup = *arg;
+    bridge_core_CommandLatency command = bridge_core_CommandLatency_init_zero;
+
+    if (!pb_decode(stream, bridge_core_CommandLatency_fields, &command)) {
+        return false;
+    }
+
+    if (command.subsystem == lookup->subsystem && command.request == lookup->request) {
+        *lookup->latency = command;
+    }
+
+    return true;
+}
+
+bool host_command_latency(struct host *host, uint32_t subsystem, uint32_t request,
+                          bridge_core_CommandLatency *latency, uint32_t *dropped) {
+    const uint32_t path[] = {bridge_Response_core_tag, bridge_core_Response_get_latency_stats_tag};
+    struct command_lookup lookup = {subsystem, request, latency};
+    bridge_core_LatencyStats stats = bridge_core_LatencyStats_init_zero;
+    bridge_Request req = bridge_Request_init_zero;
+    bridge_Response resp;
+
+    req.which_subsystem = bridge_Request_core_tag;
+    req.subsystem.core.which_request_type = bridge_core_Request_get_latency_stats_tag;
+    req.subsystem.core.request_type.get_latency_stats = true;
+    if (!host_send(host, &req) || !host_receive(host, &resp) || !resp.request_status) {
+        return false;
+    }
+
+    *latency = (bridge_core_CommandLatency)bridge_core_CommandLatency_init_zero;
+    stats.commands.funcs.decode = find_command_latency;
+    stats.commands.arg = &lookup;
+    if (!host_decode_nested(host, path, ARRAY_SIZE(path), bridge_core_LatencyStats_fields,
+                            &stats)) {
+        return false;
+    }
+
+    *dropped = stats.dropped;
+    return true;
+}
+#endif // IS_ENABLED(CONFIG_ZMK_BRIDGE_LATENCY_STATS)
@@ -0,0 +1,107 @@
+/*
+ * Copyright (c) 2025 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+#include <zephyr/kernel.h>
+#include <pb_encode.h>
+
+#include <uart_framing.h>
+#include <zmk/bridge.h>
+
+/*
+ * The host side of a loopback session, framing and checking requests and responses like a host
+ * on a UART would.
+ */
+
+#define HOST_TIMEOUT K_SECONDS(1)
+// Largest response the tests read, latency stats of several commands being the longest.
+#define HOST_FRAME_MAX 1024
+
+struct host {
+    uint8_t session;
+    struct uart_framing_decoder dec;
+    // Received but not yet decoded.
+    uint8_t wire[64];
+    size_t wire_len;
+    size_t wire_pos;
+    // One spare byte, so the decoder gets to the end of the frame.
+    uint8_t frame[HOST_FRAME_MAX + 1];
+    // Of the last frame received, without its check.
+    size_t frame_len;
+};
+
+void host_init(struct host *host, uint8_t session);
+
+/**
+ * @brief Encode @p req and append its frame check.
+ * @retval The length of the frame, 0 if it does not fit in @p size bytes.
+ */
+size_t host_encode(const bridge_Request *req, uint8_t *frame, size_t size);
+
+/**
+ * @brief Frame @p frame as it is, frame check included, and send it a few bytes at a time.
+ */
+bool host_send_frame(const struct host *host, const uint8_t *frame, size_t len);
+
+bool host_send(const struct host *host, const bridge_Request *req);
+
+// Sends bytes without framing them, for frames that are broken on purpose.
+bool host_send_wire(const struct host *host, const uint8_t *wire, size_t len);
+
+/**
+ * @brief Wait for the next frame from the Bridge, notifications and NAKs included, and decode it
+ * into @p resp. Callbacks set in @p resp are kept.
+ * @retval false if nothing arrived within @p timeout or the frame is broken.
+ */
+bool host_receive_frame(struct host *host, bridge_Response *resp, k_timeout_t timeout);
+
+// Waits for the next response, skipping notifications.
+bool host_receive(struct host *host, bridge_Response *resp);
+
+/**
+ * @brief Read and drop whatever the Bridge sends until it has been quiet for @p quiet, for
+ * example notifications queued for a session while no test read it.
+ */
+void host_drain(struct host *host, k_timeout_t quiet);
+
+/**
+ * @brief Decode a submessage of the last frame received, found by following the field numbers in
+ * @p path. nanopb clears oneof members before decoding them, callbacks included, so data that
+ * subsystem responses carry in callback fields is decoded with this.
+ */
+bool host_decode_nested(const struct host *host, const uint32_t *path, size_t depth,
+                        const pb_msgdesc_t *fields, void *dest);
+
+bridge_Request device_info_request(uint32_t request_id);
+
+#if IS_ENABLED(CONFIG_ZMK_BRIDGE_LATENCY_STATS)
+bool host_reset_latency_stats(struct host *host);
+
+/**
+ * @brief Read the latency stats and pick out those of one command.
+ * @param latency Left with no stages if the command has not been recorded.
+ * @param dropped Requests not recorded for lack of command slots.
+ */
+bool host_command_latency(struct host *host, uint32_t subsystem, uint32_t request,
+                          bridge_core_CommandLatency *latency, uint32_t *dropped);
+#endif // IS_ENABLED(CONFIG_ZMK_BRIDGE_LATENCY_STATS)
+
+struct values {
+    const uint32_t *values;
+    size_t len;
+};
+
+// Encodes a repeated uint32 field from a struct values, packed like a protobuf library would.
+bool host_encode_values(pb_ostream_t *stream, const pb_field_t *field, void *const *arg);
+
+struct batch_items {
+    const bridge_Request *requests;
+    size_t len;
+};
+
+bridge_Request batch_request(uint32_t request_id, const struct batch_items *items,
+                             bool stop_on_failure);
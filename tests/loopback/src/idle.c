@@ -0,0 +1,97 @@
+/*
+ * Copyright (c) 2025 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+/*
+ * Threads of the Bridge only run when there is something to do: a tracing hook counts how often
+ * one of them is switched in, which has to stay at 0 while the link is idle. Also prints how long
+ * a request takes from the host's side and from the Bridge's, as recorded in its latency stats.
+ */
+
+#include <string.h>
+
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+
+#include <bridge_latency.h>
+
+#include "host.h"
+
+#define IDLE_TIME K_MSEC(500)
+#define ROUND_TRIPS 20
+
+static struct host host;
+static atomic_t bridge_wakeups;
+
+// Called by the scheduler with interrupts locked, for every thread switch.
+void sys_trace_thread_switched_in_user(void) {
+    const char *name = k_thread_name_get(k_current_get());
+
+    if (name && strncmp(name, "bridge_", strlen("bridge_")) == 0) {
+        atomic_inc(&bridge_wakeups);
+    }
+}
+
+static void idle_before(void *fixture) {
+    host_init(&host, 0);
+    host_drain(&host, K_MSEC(10));
+}
+
+ZTEST_SUITE(bridge_idle, NULL, NULL, idle_before, NULL, NULL);
+
+ZTEST(bridge_idle, test_no_wakeups_while_idle) {
+    bridge_Response resp;
+
+    const atomic_val_t before = atomic_get(&bridge_wakeups);
+    k_sleep(IDLE_TIME);
+    const atomic_val_t idle = atomic_get(&bridge_wakeups) - before;
+
+    // Nothing else changed, it is the request that wakes the Bridge.
+    const bridge_Request req = device_info_request(1100);
+    zassert_true(host_send(&host, &req));
+    zassert_true(host_receive(&host, &resp));
+    const atomic_val_t busy = atomic_get(&bridge_wakeups) - before - idle;
+
+    TC_PRINT("Bridge threads switched in %ld times idle, %ld times for a request\n", (long)idle,
+             (long)busy);
+    zassert_equal(idle, 0);
+    zassert_true(busy > 0);
+}
+
+ZTEST(bridge_idle, test_round_trip_latency) {
+    bridge_core_CommandLatency latency;
+    uint32_t min_us = UINT32_MAX;
+    uint32_t max_us = 0;
+    uint32_t total_us = 0;
+    uint32_t dropped;
+
+    zassert_true(host_reset_latency_stats(&host));
+
+    for (int i = 0; i < ROUND_TRIPS; i++) {
+        const bridge_Request req = device_info_request(1110 + i);
+        bridge_Response resp;
+
+        const uint32_t start = k_cycle_get_32();
+        zassert_true(host_send(&host, &req));
+        zassert_true(host_receive(&host, &resp));
+        const uint32_t us = k_cyc_to_us_floor32(k_cycle_get_32() - start);
+
+        zassert_equal(resp.request_id, 1110 + i);
+        min_us = MIN(min_us, us);
+        max_us = MAX(max_us, us);
+        total_us += us;
+    }
+
+    zassert_true(host_command_latency(&host, bridge_Request_core_tag,
+                                      bridge_core_Request_get_device_info_tag, &latency, &dropped));
+    zassert_equal(latency.stages_count, BRIDGE_LATENCY_STAGE_COUNT);
+
+    TC_PRINT("Round trip: min %u us, avg %u us, max %u us\n", min_us, total_us / ROUND_TRIPS,
+             max_us);
+    for (int i = 0; i < latency.stages_count; i++) {
+        zassert_equal(latency.stages[i].count, ROUND_TRIPS);
+        TC_PRINT("Bridge stage %d: max %u us\n", i, latency.stages[i].max_us);
+    }
+}
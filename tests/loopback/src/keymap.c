@@ -0,0 +1,309 @@
+/*
+ * Copyright (c) 2025 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+/*
+ * The keymap subsystem reading and writing a keymap kept by the test in place of ZMK's, with the
+ * layers and positions of subsystems.overlay.
+ */
+
+#include <string.h>
+
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+#include <pb_decode.h>
+
+#include <zmk/behavior.h>
+#include <zmk/keymap.h>
+#include <zmk/matrix.h>
+
+#include "host.h"
+
+#define LAYERS ZMK_KEYMAP_LAYERS_LEN
+#define POSITIONS ZMK_KEYMAP_LEN
+#define MAX_BINDINGS CONFIG_ZMK_BRIDGE_KEYMAP_MAX_BINDINGS
+#define VALUES_PER_BINDING 3
+
+BUILD_ASSERT(MAX_BINDINGS < POSITIONS, "Reads have to stop short of the end of a layer");
+
+// Local ids index this, 0 is left out so there is an id without a behavior.
+static const char *const behaviors[] = {NULL, "none", "rgb_ug"};
+#define NONE_ID 1
+#define RGB_UG_ID 2
+#define UNKNOWN_ID ARRAY_SIZE(behaviors)
+
+static struct host host;
+
+// By layer id. The params of the initial bindings only tell them apart.
+static struct zmk_behavior_binding keymap[LAYERS][POSITIONS];
+
+zmk_behavior_local_id_t zmk_behavior_get_local_id(const char *name) {
+    for (int i = 1; i < ARRAY_SIZE(behaviors); i++) {
+        if (strcmp(behaviors[i], name) == 0) {
+            return i;
+        }
+    }
+
+    return UINT16_MAX;
+}
+
+const char *zmk_behavior_find_behavior_name_from_local_id(zmk_behavior_local_id_t local_id) {
+    return local_id < ARRAY_SIZE(behaviors) ? behaviors[local_id] : NULL;
+}
+
+// Layer ids are the indices backwards, so mixing them up shows.
+zmk_keymap_layer_id_t zmk_keymap_layer_index_to_id(zmk_keymap_layer_index_t layer_index) {
+    return layer_index < LAYERS ? LAYERS - 1 - layer_index : ZMK_KEYMAP_LAYER_ID_INVAL;
+}
+
+const struct zmk_behavior_binding *
+zmk_keymap_get_layer_binding_at_idx(zmk_keymap_layer_id_t layer_id, uint8_t binding_idx) {
+    return layer_id < LAYERS && binding_idx < POSITIONS ? &keymap[layer_id][binding_idx] : NULL;
+}
+
+int zmk_keymap_set_layer_binding_at_idx(zmk_keymap_layer_id_t layer_id, uint8_t binding_idx,
+                                        const struct zmk_behavior_binding binding) {
+    if (layer_id >= LAYERS || binding_idx >= POSITIONS) {
+        return -EINVAL;
+    }
+
+    keymap[layer_id][binding_idx] = binding;
+    return 0;
+}
+
+struct read_values {
+    uint32_t values[POSITIONS * VALUES_PER_BINDING];
+    size_t len;
+};
+
+static bool decode_read_value(pb_istream_t *stream, const pb_field_t *field, void **arg) {
+    struct read_values *read = *arg;
+
+    return read->len < ARRAY_SIZE(read->values) &&
+           pb_decode_varint32(stream, &read->values[read->len++]);
+}
+
+// Reads the range and checks the values against the keymap, count bindings of them.
+static void expect_read(uint32_t request_id, uint32_t layer, uint32_t start, uint32_t count,
+                        uint32_t expected_count) {
+    const uint32_t path[] = {bridge_Response_keymap_tag, bridge_keymap_Response_read_bindings_tag};
+    bridge_keymap_Bindings bindings = bridge_keymap_Bindings_init_zero;
+    struct read_values read = {0};
+    bridge_Request req = bridge_Request_init_zero;
+    bridge_Response resp;
+
+    req.request_id = request_id;
+    req.which_subsystem = bridge_Request_keymap_tag;
+    req.subsystem.keymap.which_request_type = bridge_keymap_Request_read_bindings_tag;
+    req.subsystem.keymap.request_type.read_bindings.layer = layer;
+    req.subsystem.keymap.request_type.read_bindings.start = start;
+    req.subsystem.keymap.request_type.read_bindings.count = count;
+
+    zassert_true(host_send(&host, &req));
+    zassert_true(host_receive(&host, &resp));
+    zassert_equal(resp.request_id, request_id);
+    zassert_true(resp.request_status);
+    zassert_equal(resp.subsystem.keymap.which_response_type,
+                  bridge_keymap_Response_read_bindings_tag);
+
+    // The values are packed into one field of the response, the oneof it is in left them out.
+    bindings.values.funcs.decode = decode_read_value;
+    bindings.values.arg = &read;
+    zassert_true(host_decode_nested(&host, path, ARRAY_SIZE(path), bridge_keymap_Bindings_fields,
+                                    &bindings));
+    zassert_equal(bindings.layer, layer);
+    zassert_equal(bindings.start, start);
+    zassert_equal(read.len, expected_count * VALUES_PER_BINDING, "Read %d values", (int)read.len);
+
+    const struct zmk_behavior_binding *layer_bindings = keymap[zmk_keymap_layer_index_to_id(layer)];
+    for (uint32_t i = 0; i < expected_count; i++) {
+        const struct zmk_behavior_binding *binding = &layer_bindings[start + i];
+        const uint32_t *values = &read.values[i * VALUES_PER_BINDING];
+        zassert_equal(values[0], zmk_behavior_get_local_id(binding->behavior_dev));
+        zassert_equal(values[1], binding->param1);
+        zassert_equal(values[2], binding->param2);
+    }
+}
+
+static bridge_Request write_bindings_request(uint32_t request_id, uint32_t layer, uint32_t start,
+                                             const struct values *values) {
+    bridge_Request req = bridge_Request_init_zero;
+    bridge_keymap_Bindings *bindings = &req.subsystem.keymap.request_type.write_bindings;
+
+    req.request_id = request_id;
+    req.which_subsystem = bridge_Request_keymap_tag;
+    req.subsystem.keymap.which_request_type = bridge_keymap_Request_write_bindings_tag;
+    bindings->layer = layer;
+    bindings->start = start;
+    bindings->values.funcs.encode = host_encode_values;
+    bindings->values.arg = (void *)values;
+    return req;
+}
+
+static void write_bindings(uint32_t request_id, uint32_t layer, uint32_t start,
+                           const uint32_t *values, size_t len, bool status) {
+    const struct values write_values = {values, len};
+    const bridge_Request req = write_bindings_request(request_id, layer, start, &write_values);
+    bridge_Response resp;
+
+    zassert_true(host_send(&host, &req));
+    zassert_true(host_receive(&host, &resp));
+    zassert_equal(resp.request_id, request_id);
+    zassert_equal(resp.request_status, status, "Request %d", request_id);
+    if (status) {
+        zassert_equal(resp.subsystem.keymap.response_type.write_bindings,
+                      len / VALUES_PER_BINDING);
+    }
+}
+
+static void expect_binding(uint32_t layer, uint32_t position, const char *behavior,
+                           uint32_t param1, uint32_t param2) {
+    const struct zmk_behavior_binding *binding =
+        &keymap[zmk_keymap_layer_index_to_id(layer)][position];
+
+    zassert_str_equal(binding->behavior_dev, behavior);
+    zassert_equal(binding->param1, param1);
+    zassert_equal(binding->param2, param2);
+}
+
+static void keymap_before(void *fixture) {
+    for (int id = 0; id < LAYERS; id++) {
+        for (int position = 0; position < POSITIONS; position++) {
+            keymap[id][position] = (struct zmk_behavior_binding){
+                .behavior_dev = behaviors[NONE_ID],
+                .param1 = id,
+                .param2 = position,
+            };
+        }
+    }
+
+    host_init(&host, 0);
+    host_drain(&host, K_MSEC(10));
+}
+
+ZTEST_SUITE(bridge_keymap, NULL, NULL, keymap_before, NULL, NULL);
+
+ZTEST(bridge_keymap, test_get_info) {
+    bridge_Request req = bridge_Request_init_zero;
+    bridge_Response resp;
+
+    req.request_id = 1600;
+    req.which_subsystem = bridge_Request_keymap_tag;
+    req.subsystem.keymap.which_request_type = bridge_keymap_Request_get_info_tag;
+    req.subsystem.keymap.request_type.get_info = true;
+    zassert_true(host_send(&host, &req));
+    zassert_true(host_receive(&host, &resp));
+    zassert_equal(resp.request_id, 1600);
+    zassert_true(resp.request_status);
+    zassert_equal(resp.subsystem.keymap.response_type.get_info.layers, LAYERS);
+    zassert_equal(resp.subsystem.keymap.response_type.get_info.positions, POSITIONS);
+    zassert_equal(resp.subsystem.keymap.response_type.get_info.max_bindings, MAX_BINDINGS);
+}
+
+ZTEST(bridge_keymap, test_read) {
+    // A count of 0 reads to the end of the layer, up to the most a request takes.
+    expect_read(1700, 0, 0, 0, MIN(POSITIONS, MAX_BINDINGS));
+    expect_read(1701, 1, 0, 0, MIN(POSITIONS, MAX_BINDINGS));
+    expect_read(1702, 1, MAX_BINDINGS, 0, POSITIONS - MAX_BINDINGS);
+
+    // Counts past the end of the layer stop at it.
+    expect_read(1703, 0, 1, 2, 2);
+    expect_read(1704, 0, POSITIONS - 1, 2, 1);
+}
+
+ZTEST(bridge_keymap, test_read_out_of_range) {
+    bridge_Request req = bridge_Request_init_zero;
+    bridge_Response resp;
+
+    req.request_id = 1710;
+    req.which_subsystem = bridge_Request_keymap_tag;
+    req.subsystem.keymap.which_request_type = bridge_keymap_Request_read_bindings_tag;
+    req.subsystem.keymap.request_type.read_bindings.layer = LAYERS;
+    zassert_true(host_send(&host, &req));
+    zassert_true(host_receive(&host, &resp));
+    zassert_false(resp.request_status);
+
+    req.request_id = 1711;
+    req.subsystem.keymap.request_type.read_bindings.layer = 0;
+    req.subsystem.keymap.request_type.read_bindings.start = POSITIONS;
+    zassert_true(host_send(&host, &req));
+    zassert_true(host_receive(&host, &resp));
+    zassert_false(resp.request_status);
+}
+
+ZTEST(bridge_keymap, test_write) {
+    const uint32_t values[] = {RGB_UG_ID, 5, 6, NONE_ID, 7, 8};
+
+    write_bindings(1800, 0, 1, values, ARRAY_SIZE(values), true);
+    expect_binding(0, 0, "none", 1, 0);
+    expect_binding(0, 1, "rgb_ug", 5, 6);
+    expect_binding(0, 2, "none", 7, 8);
+    expect_binding(0, 3, "none", 1, 3);
+
+    // The other layer is left alone, and reads see the new bindings.
+    expect_binding(1, 1, "none", 0, 1);
+    expect_read(1801, 0, 0, 0, MIN(POSITIONS, MAX_BINDINGS));
+}
+
+ZTEST(bridge_keymap, test_write_rejected) {
+    static struct zmk_behavior_binding before[LAYERS][POSITIONS];
+    bridge_Response resp = bridge_Response_init_zero;
+    const uint32_t unknown[] = {RGB_UG_ID, 1, 2, UNKNOWN_ID, 3, 4};
+    const uint32_t no_behavior[] = {0, 1, 2};
+    const uint32_t partial[] = {NONE_ID, 1, 2, NONE_ID};
+    const uint32_t two[] = {NONE_ID, 1, 2, NONE_ID, 3, 4};
+
+    memcpy(before, keymap, sizeof(keymap));
+
+    // Every binding is checked before the first is written.
+    write_bindings(1900, 0, 0, unknown, ARRAY_SIZE(unknown), false);
+    write_bindings(1901, 0, 0, no_behavior, ARRAY_SIZE(no_behavior), false);
+    write_bindings(1902, 0, 0, partial, ARRAY_SIZE(partial), false);
+    write_bindings(1903, 0, 0, NULL, 0, false);
+    write_bindings(1904, LAYERS, 0, two, ARRAY_SIZE(two), false);
+    write_bindings(1905, 0, POSITIONS - 1, two, ARRAY_SIZE(two), false);
+
+    // More values than are staged fail to decode.
+    uint32_t too_many[(MAX_BINDINGS + 1) * VALUES_PER_BINDING];
+    for (int i = 0; i < ARRAY_SIZE(too_many); i++) {
+        too_many[i] = i % VALUES_PER_BINDING == 0 ? NONE_ID : i;
+    }
+    const struct values too_many_values = {too_many, ARRAY_SIZE(too_many)};
+    const bridge_Request req = write_bindings_request(1906, 0, 0, &too_many_values);
+    zassert_true(host_send(&host, &req));
+    zassert_true(host_receive_frame(&host, &resp, HOST_TIMEOUT));
+    zassert_true(resp.has_nak);
+    zassert_equal(resp.nak.reason, bridge_NakReason_NAK_REASON_DECODE_FAILED);
+
+    zassert_mem_equal(keymap, before, sizeof(keymap));
+}
+
+ZTEST(bridge_keymap, test_write_batched) {
+    static struct zmk_behavior_binding before[LAYERS][POSITIONS];
+    bridge_Response resp;
+    const uint32_t values[] = {RGB_UG_ID, 1, 2};
+    const uint32_t other[] = {RGB_UG_ID, 3, 4};
+    const struct values write_values = {values, ARRAY_SIZE(values)};
+
+    memcpy(before, keymap, sizeof(keymap));
+
+    // Bindings are staged data, which batches do not take.
+    const bridge_Request items[] = {write_bindings_request(0, 0, 0, &write_values),
+                                    device_info_request(0)};
+    const struct batch_items batch = {items, ARRAY_SIZE(items)};
+    const bridge_Request req = batch_request(2000, &batch, false);
+    zassert_true(host_send(&host, &req));
+    zassert_true(host_receive(&host, &resp));
+    zassert_equal(resp.request_id, 2000);
+    zassert_false(resp.request_status);
+    zassert_equal(resp.batch.executed, 2);
+    zassert_equal(resp.batch.status_bitmap, 0b10);
+    zassert_mem_equal(keymap, before, sizeof(keymap));
+
+    // Nothing of the batch was left staged for the next write.
+    write_bindings(2001, 1, 3, other, ARRAY_SIZE(other), true);
+    expect_binding(1, 3, "rgb_ug", 3, 4);
+    expect_binding(1, 0, "none", 0, 0);
+}
@@ -0,0 +1,128 @@
+/*
+ * Copyright (c) 2025 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+/*
+ * Stands in for the keymap subsystem where it is not built: write_bindings values are decoded into
+ * a staging buffer, as keymap.c does, and the handler reports how many it found.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+#include <pb_decode.h>
+
+#include "host.h"
+
+static uint32_t staged_values[6];
+static size_t staged_len;
+static int write_bindings_calls;
+
+static bool stage_value(pb_istream_t *stream, const pb_field_t *field, void **arg) {
+    uint32_t value;
+
+    if (!pb_decode_varint32(stream, &value) || staged_len >= ARRAY_SIZE(staged_values)) {
+        return false;
+    }
+
+    staged_values[staged_len++] = value;
+    return true;
+}
+
+static bool decode_request_type(pb_istream_t *stream, const pb_field_t *field, void **arg) {
+    const bool batched = (uintptr_t)*arg;
+
+    if (field->tag == bridge_keymap_Request_write_bindings_tag) {
+        bridge_keymap_Bindings *bindings = field->pData;
+        bindings->values.funcs.decode = batched ? bridge_decode_batch_reject : stage_value;
+        if (!batched) {
+            staged_len = 0;
+        }
+    }
+
+    return true;
+}
+
+static bool keymap_prepare_decode(pb_istream_t *stream, const pb_field_t *field, bool batched) {
+    bridge_keymap_Request *keymap_req = field->pData;
+    keymap_req->cb_request_type.funcs.decode = decode_request_type;
+    keymap_req->cb_request_type.arg = (void *)(uintptr_t)batched;
+    return true;
+}
+
+static void keymap_discard_decode(const bridge_Request *req) { staged_len = 0; }
+
+static bridge_Response write_bindings(const bridge_Request *req) {
+    const size_t len = staged_len;
+    staged_len = 0;
+    write_bindings_calls++;
+
+    bridge_Response resp = BRIDGE_RESPONSE(keymap, write_bindings, len);
+    resp.request_status = len > 0;
+    return resp;
+}
+
+BRIDGE_SUBSYSTEM_DECODER(keymap, keymap_prepare_decode, keymap_discard_decode);
+BRIDGE_SUBSYSTEM_HANDLER(keymap, write_bindings);
+
+static bridge_Request write_bindings_request(uint32_t request_id, const struct values *values) {
+    bridge_Request req = bridge_Request_init_zero;
+
+    req.request_id = request_id;
+    req.which_subsystem = bridge_Request_keymap_tag;
+    req.subsystem.keymap.which_request_type = bridge_keymap_Request_write_bindings_tag;
+    req.subsystem.keymap.request_type.write_bindings.values.funcs.encode = host_encode_values;
+    req.subsystem.keymap.request_type.write_bindings.values.arg = (void *)values;
+    return req;
+}
+
+ZTEST(bridge_loopback, test_batch_rejects_staged_data) {
+    struct host host;
+    bridge_Response resp;
+    const uint32_t values[] = {1, 2, 3};
+    const struct values some = {values, ARRAY_SIZE(values)};
+    const struct values none = {NULL, 0};
+
+    host_init(&host, 0);
+    write_bindings_calls = 0;
+
+    // Outside of a batch the values reach the handler.
+    bridge_Request req = write_bindings_request(500, &some);
+    zassert_true(host_send(&host, &req));
+    zassert_true(host_receive(&host, &resp));
+    zassert_equal(resp.request_id, 500);
+    zassert_true(resp.request_status);
+    zassert_equal(resp.subsystem.keymap.response_type.write_bindings, ARRAY_SIZE(values));
+
+    // Within one they fail without running the handler, the other requests still run.
+    const bridge_Request items[] = {device_info_request(0), write_bindings_request(0, &some),
+                                    device_info_request(0)};
+    const struct batch_items batch = {items, ARRAY_SIZE(items)};
+
+    req = batch_request(501, &batch, false);
+    zassert_true(host_send(&host, &req));
+    zassert_true(host_receive(&host, &resp));
+    zassert_equal(resp.request_id, 501);
+    zassert_false(resp.request_status);
+    zassert_equal(resp.batch.executed, 3);
+    zassert_equal(resp.batch.status_bitmap, 0b101);
+
+    req = batch_request(502, &batch, true);
+    zassert_true(host_send(&host, &req));
+    zassert_true(host_receive(&host, &resp));
+    zassert_equal(resp.request_id, 502);
+    zassert_false(resp.request_status);
+    zassert_equal(resp.batch.executed, 2);
+    zassert_equal(resp.batch.status_bitmap, 0b01);
+
+    zassert_equal(write_bindings_calls, 1);
+
+    // Nothing of the rejected values was left staged for the next write.
+    req = write_bindings_request(503, &none);
+    zassert_true(host_send(&host, &req));
+    zassert_true(host_receive(&host, &resp));
+    zassert_equal(resp.request_id, 503);
+    zassert_false(resp.request_status);
+    zassert_equal(resp.subsystem.keymap.response_type.write_bindings, 0);
+}
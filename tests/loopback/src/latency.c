@@ -0,0 +1,141 @@
+/*
+ * Copyright (c) 2025 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+/*
+ * Latency histograms as the host reads them, after the stats have been reset at the start of each
+ * test. A request is recorded once its response has been sent, so the stats read by a request never
+ * include that request itself.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+
+#include <bridge_latency.h>
+
+#include "host.h"
+
+static struct host host;
+
+static void expect_histograms(const bridge_core_CommandLatency *latency, uint32_t count) {
+    zassert_equal(latency->stages_count, BRIDGE_LATENCY_STAGE_COUNT);
+
+    for (int i = 0; i < latency->stages_count; i++) {
+        const bridge_core_LatencyHistogram *histogram = &latency->stages[i];
+        uint32_t bucket_sum = 0;
+
+        for (int j = 0; j < histogram->buckets_count; j++) {
+            bucket_sum += histogram->buckets[j];
+        }
+
+        zassert_equal(histogram->stage, i);
+        zassert_equal(histogram->buckets_count, BRIDGE_LATENCY_BUCKETS);
+        zassert_equal(histogram->count, count, "Stage %d", i);
+        zassert_equal(bucket_sum, count, "Stage %d", i);
+    }
+}
+
+static void latency_before(void *fixture) {
+    host_init(&host, 0);
+    host_drain(&host, K_MSEC(10));
+    zassert_true(host_reset_latency_stats(&host));
+}
+
+ZTEST_SUITE(bridge_latency, NULL, NULL, latency_before, NULL, NULL);
+
+ZTEST(bridge_latency, test_histograms) {
+    bridge_core_CommandLatency latency;
+    bridge_Response resp;
+    uint32_t dropped;
+
+    for (int i = 0; i < 5; i++) {
+        const bridge_Request req = device_info_request(1000 + i);
+        zassert_true(host_send(&host, &req));
+        zassert_true(host_receive(&host, &resp));
+    }
+
+    zassert_true(host_command_latency(&host, bridge_Request_core_tag,
+                                      bridge_core_Request_get_device_info_tag, &latency, &dropped));
+    zassert_equal(latency.subsystem, bridge_Request_core_tag);
+    zassert_equal(latency.request, bridge_core_Request_get_device_info_tag);
+    expect_histograms(&latency, 5);
+    zassert_equal(dropped, 0);
+
+    // Requests of the Bridge itself are recorded without a subsystem.
+    bridge_Request req = bridge_Request_init_zero;
+    req.get_bridge_info = true;
+    zassert_true(host_send(&host, &req));
+    zassert_true(host_receive(&host, &resp));
+
+    zassert_true(host_command_latency(&host, 0, bridge_Request_get_bridge_info_tag, &latency,
+                                      &dropped));
+    expect_histograms(&latency, 1);
+}
+
+ZTEST(bridge_latency, test_reset) {
+    bridge_core_CommandLatency latency;
+    uint32_t dropped;
+
+    const bridge_Request req = device_info_request(1010);
+    bridge_Response resp;
+    zassert_true(host_send(&host, &req));
+    zassert_true(host_receive(&host, &resp));
+
+    zassert_true(host_reset_latency_stats(&host));
+    zassert_true(host_command_latency(&host, bridge_Request_core_tag,
+                                      bridge_core_Request_get_device_info_tag, &latency, &dropped));
+    zassert_equal(latency.stages_count, 0);
+    zassert_equal(dropped, 0);
+}
+
+ZTEST(bridge_latency, test_async_handler) {
+    bridge_core_CommandLatency latency;
+    uint32_t dropped;
+
+    // Recorded once completed, before the next read takes its snapshot.
+    zassert_true(host_command_latency(&host, bridge_Request_core_tag,
+                                      bridge_core_Request_get_latency_stats_tag, &latency,
+                                      &dropped));
+    zassert_equal(latency.stages_count, 0);
+
+    zassert_true(host_command_latency(&host, bridge_Request_core_tag,
+                                      bridge_core_Request_get_latency_stats_tag, &latency,
+                                      &dropped));
+    expect_histograms(&latency, 1);
+}
+
+ZTEST(bridge_latency, test_dropped) {
+    bridge_core_CommandLatency latency;
+    bridge_Response resp;
+    uint32_t dropped;
+
+    bridge_Request bridge_info = bridge_Request_init_zero;
+    bridge_info.get_bridge_info = true;
+    bridge_Request link_stats = bridge_Request_init_zero;
+    link_stats.get_link_stats = true;
+    const bridge_Request items[] = {device_info_request(0)};
+    const struct batch_items batch = {items, ARRAY_SIZE(items)};
+    const bridge_Request requests[] = {device_info_request(1020), bridge_info, link_stats,
+                                       batch_request(1021, &batch, false)};
+
+    for (int i = 0; i < ARRAY_SIZE(requests); i++) {
+        zassert_true(host_send(&host, &requests[i]));
+        zassert_true(host_receive(&host, &resp));
+    }
+
+    // reset_latency_stats from latency_before() took a slot as well.
+    const int commands = ARRAY_SIZE(requests) + 1;
+    zassert_true(host_command_latency(&host, 0, bridge_Request_batch_tag, &latency, &dropped));
+    zassert_equal(dropped, MAX(commands - CONFIG_ZMK_BRIDGE_LATENCY_STATS_MAX_COMMANDS, 0));
+    zassert_equal(latency.stages_count,
+                  commands > CONFIG_ZMK_BRIDGE_LATENCY_STATS_MAX_COMMANDS
+                      ? 0
+                      : BRIDGE_LATENCY_STAGE_COUNT);
+
+    // Commands already recorded are still counted.
+    zassert_true(host_command_latency(&host, bridge_Request_core_tag,
+                                      bridge_core_Request_get_device_info_tag, &latency, &dropped));
+    expect_histograms(&latency, 1);
+}
@@ -0,0 +1,249 @@
+/*
+ * Copyright (c) 2025 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+/*
+ * Frames that get damaged or cut off on the way, or that do not fit: each one is NAKed and counted
+ * in the link stats, and the next frame is handled as usual.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+#include <pb_encode.h>
+
+#include "host.h"
+
+// Not a field of bridge.Request, skipped by the decoder.
+#define PADDING_FIELD 100
+
+static struct host host;
+
+static void link_stats(bridge_LinkStats *stats) {
+    bridge_Request req = bridge_Request_init_zero;
+    bridge_Response resp;
+
+    req.get_link_stats = true;
+    zassert_true(host_send(&host, &req));
+    zassert_true(host_receive(&host, &resp));
+    zassert_true(resp.has_link_stats);
+    *stats = resp.link_stats;
+}
+
+static void expect_nak(bridge_NakReason reason) {
+    bridge_Response resp = bridge_Response_init_zero;
+
+    zassert_true(host_receive_frame(&host, &resp, HOST_TIMEOUT), "No NAK");
+    zassert_true(resp.has_nak, "Got a response instead of a NAK");
+    zassert_equal(resp.nak.reason, reason);
+}
+
+static void expect_device_info(uint32_t request_id) {
+    bridge_Response resp;
+
+    zassert_true(host_receive(&host, &resp));
+    zassert_false(resp.has_nak);
+    zassert_equal(resp.request_id, request_id);
+    zassert_true(resp.request_status);
+    zassert_equal(resp.which_subsystem, bridge_Response_core_tag);
+}
+
+/*
+ * A device info request padded with an unknown field to exactly len bytes, frame check included.
+ * len has to leave room for the request and at least 130 bytes of padding.
+ */
+static void padded_request(uint32_t request_id, uint8_t *frame, size_t len) {
+    const bridge_Request req = device_info_request(request_id);
+    const uint8_t zeros[32] = {0};
+    pb_ostream_t stream = pb_ostream_from_buffer(frame, len - UART_FRAMING_CHECK_LEN);
+
+    zassert_true(pb_encode(&stream, bridge_Request_fields, &req));
+
+    // Tag and length of the padding take four bytes, as long as it is 128 bytes or more.
+    size_t padding = len - UART_FRAMING_CHECK_LEN - stream.bytes_written - 4;
+    zassert_true(padding >= 128 && padding < 16384);
+    zassert_true(pb_encode_tag(&stream, PB_WT_STRING, PADDING_FIELD));
+    zassert_true(pb_encode_varint(&stream, padding));
+    while (padding > 0) {
+        const size_t chunk = MIN(padding, sizeof(zeros));
+        zassert_true(pb_write(&stream, zeros, chunk));
+        padding -= chunk;
+    }
+
+    zassert_equal(stream.bytes_written, len - UART_FRAMING_CHECK_LEN);
+    uart_framing_check_put(
+        uart_framing_check_update(uart_framing_check_init(), frame, stream.bytes_written),
+        &frame[stream.bytes_written]);
+}
+
+// Frames frame into wire, so several frames can be handed over at once.
+static size_t frame_wire(const uint8_t *frame, size_t len, uint8_t *wire, size_t size) {
+    struct uart_framing_encoder enc;
+    size_t consumed;
+    bool done;
+
+    uart_framing_encoder_init(&enc, UART_FRAMING_CODEC_ESCAPE);
+    size_t wire_len = uart_framing_encode(&enc, frame, len, &consumed, wire, size);
+    wire_len += uart_framing_encode_end(&enc, &wire[wire_len], size - wire_len, &done);
+    return consumed == len && done ? wire_len : 0;
+}
+
+static void link_before(void *fixture) {
+    host_init(&host, 0);
+    host_drain(&host, K_MSEC(10));
+}
+
+ZTEST_SUITE(bridge_link, NULL, NULL, link_before, NULL, NULL);
+
+ZTEST(bridge_link, test_check_failure) {
+    bridge_LinkStats before, after;
+    uint8_t frame[64];
+
+    if (UART_FRAMING_CHECK_LEN == 0) {
+        ztest_test_skip();
+    }
+
+    link_stats(&before);
+
+    const bridge_Request req = device_info_request(600);
+    const size_t len = host_encode(&req, frame, sizeof(frame));
+    zassert_true(len > 0);
+
+    // A flipped bit in the data, and one in the check value itself.
+    frame[0] ^= BIT(2);
+    zassert_true(host_send_frame(&host, frame, len));
+    expect_nak(bridge_NakReason_NAK_REASON_CHECK_FAILED);
+    frame[0] ^= BIT(2);
+
+    frame[len - 1] ^= BIT(7);
+    zassert_true(host_send_frame(&host, frame, len));
+    expect_nak(bridge_NakReason_NAK_REASON_CHECK_FAILED);
+    frame[len - 1] ^= BIT(7);
+
+    // The host retransmits, and this time it goes through.
+    zassert_true(host_send_frame(&host, frame, len));
+    expect_device_info(600);
+
+    link_stats(&after);
+    zassert_equal(after.check_failures - before.check_failures, 2);
+    zassert_equal(after.decode_failures, before.decode_failures);
+}
+
+ZTEST(bridge_link, test_rx_timeout) {
+    const uint8_t partial[] = {FRAMING_SOF, 0x08, 0x01};
+    bridge_LinkStats before, after;
+
+    if (CONFIG_ZMK_BRIDGE_RX_TIMEOUT_MS == 0) {
+        ztest_test_skip();
+    }
+
+    link_stats(&before);
+
+    // The rest of the frame never comes.
+    const int64_t start = k_uptime_get();
+    zassert_true(host_send_wire(&host, partial, sizeof(partial)));
+    expect_nak(bridge_NakReason_NAK_REASON_TIMEOUT);
+    const int64_t elapsed = k_uptime_get() - start;
+    zassert_true(elapsed >= CONFIG_ZMK_BRIDGE_RX_TIMEOUT_MS, "NAKed after %d ms", (int)elapsed);
+
+    // The stale bytes were dropped, the next frame starts from scratch.
+    const bridge_Request req = device_info_request(610);
+    zassert_true(host_send(&host, &req));
+    expect_device_info(610);
+
+    link_stats(&after);
+    zassert_equal(after.timeouts - before.timeouts, 1);
+}
+
+ZTEST(bridge_link, test_aborted_frame) {
+    const uint8_t partial[] = {FRAMING_SOF, 0x08, 0x01};
+    bridge_LinkStats before, after;
+
+    link_stats(&before);
+
+    // The SOF of the next frame cuts this one short, and starts a frame that is received.
+    zassert_true(host_send_wire(&host, partial, sizeof(partial)));
+    const bridge_Request req = device_info_request(620);
+    zassert_true(host_send(&host, &req));
+
+    // NAKs go out ahead of responses.
+    expect_nak(bridge_NakReason_NAK_REASON_FRAME_ABORTED);
+    expect_device_info(620);
+
+    link_stats(&after);
+    zassert_equal(after.aborted_frames - before.aborted_frames, 1);
+    zassert_equal(after.timeouts, before.timeouts);
+}
+
+ZTEST(bridge_link, test_decode_failure) {
+    // A varint that runs past the end of the frame.
+    uint8_t frame[3 + UART_FRAMING_CHECK_LEN] = {0xff, 0xff, 0xff};
+    bridge_LinkStats before, after;
+
+    link_stats(&before);
+
+    uart_framing_check_put(uart_framing_check_update(uart_framing_check_init(), frame, 3),
+                           &frame[3]);
+    zassert_true(host_send_frame(&host, frame, sizeof(frame)));
+    expect_nak(bridge_NakReason_NAK_REASON_DECODE_FAILED);
+
+    const bridge_Request req = device_info_request(630);
+    zassert_true(host_send(&host, &req));
+    expect_device_info(630);
+
+    link_stats(&after);
+    zassert_equal(after.decode_failures - before.decode_failures, 1);
+    zassert_equal(after.check_failures, before.check_failures);
+}
+
+ZTEST(bridge_link, test_frame_size_limit) {
+    uint8_t frame[CONFIG_ZMK_BRIDGE_RX_FRAME_SIZE + 1];
+    bridge_LinkStats before, after;
+
+    link_stats(&before);
+
+    // The largest frame that fits in a frame buffer is handled as usual.
+    padded_request(640, frame, CONFIG_ZMK_BRIDGE_RX_FRAME_SIZE);
+    zassert_true(host_send_frame(&host, frame, CONFIG_ZMK_BRIDGE_RX_FRAME_SIZE));
+    expect_device_info(640);
+
+    // One byte more and it is dropped as a whole.
+    padded_request(641, frame, sizeof(frame));
+    zassert_true(host_send_frame(&host, frame, sizeof(frame)));
+    expect_nak(bridge_NakReason_NAK_REASON_FRAME_TOO_LARGE);
+
+    const bridge_Request req = device_info_request(642);
+    zassert_true(host_send(&host, &req));
+    expect_device_info(642);
+
+    link_stats(&after);
+    zassert_equal(after.oversized_frames - before.oversized_frames, 1);
+}
+
+ZTEST(bridge_link, test_overrun) {
+    uint8_t wire[CONFIG_ZMK_BRIDGE_RX_FRAME_COUNT * 32 + 32];
+    uint8_t frame[32];
+    size_t wire_len = 0;
+    bridge_LinkStats before, after;
+
+    link_stats(&before);
+
+    // Handed over in one go, the frame after the last free frame buffer has nowhere to go.
+    for (int i = 0; i <= CONFIG_ZMK_BRIDGE_RX_FRAME_COUNT; i++) {
+        const bridge_Request req = device_info_request(650 + i);
+        const size_t len = host_encode(&req, frame, sizeof(frame));
+        const size_t framed = frame_wire(frame, len, &wire[wire_len], sizeof(wire) - wire_len);
+        zassert_true(len > 0 && framed > 0);
+        wire_len += framed;
+    }
+
+    zassert_true(host_send_wire(&host, wire, wire_len));
+    expect_nak(bridge_NakReason_NAK_REASON_OVERRUN);
+    for (int i = 0; i < CONFIG_ZMK_BRIDGE_RX_FRAME_COUNT; i++) {
+        expect_device_info(650 + i);
+    }
+
+    link_stats(&after);
+    zassert_equal(after.overruns - before.overruns, 1);
+}
@@ -0,0 +1,194 @@
+/*
+ * Copyright (c) 2025 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+/*
+ * Plays the host over the loopback transport, so requests take the same framing, decode, dispatch
+ * and response path as over a UART.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/ztest.h>
+
+#include <zmk/bridge.h>
+#include <zmk/bridge_loopback.h>
+
+#include "host.h"
+
+LOG_MODULE_REGISTER(bridge_loopback_test, LOG_LEVEL_INF);
+
+#define PIPELINE_DEPTH CONFIG_ZMK_BRIDGE_RX_FRAME_COUNT
+
+/*
+ * Sends as many requests as there are frame buffers, so none has to wait for the host to read,
+ * before reading the responses. They have to come back in order, each for its own request.
+ */
+static bool host_pipeline(struct host *host, uint32_t first_id) {
+    for (int i = 0; i < PIPELINE_DEPTH; i++) {
+        bridge_Request req = device_info_request(first_id + i);
+        if (i % 3 != 0) {
+            req = (bridge_Request)bridge_Request_init_zero;
+            req.request_id = first_id + i;
+            req.get_bridge_info = i % 3 == 1;
+            req.get_link_stats = i % 3 == 2;
+        }
+
+        if (!host_send(host, &req)) {
+            return false;
+        }
+    }
+
+    for (int i = 0; i < PIPELINE_DEPTH; i++) {
+        bridge_Response resp;
+        if (!host_receive(host, &resp)) {
+            return false;
+        }
+
+        const bool kind_matches = i % 3 == 0   ? resp.which_subsystem == bridge_Response_core_tag
+                                  : i % 3 == 1 ? resp.has_bridge_info
+                                               : resp.has_link_stats;
+        if (resp.request_id != first_id + i || !resp.request_status || !kind_matches) {
+            TC_PRINT("Session %d: response %d answers request %d\n", host->session, i,
+                     resp.request_id - first_id);
+            return false;
+        }
+    }
+
+    return true;
+}
+
+#define SESSION_ROUNDS 8
+
+K_THREAD_STACK_DEFINE(second_host_stack, 4096);
+static struct k_thread second_host_thread;
+static bool second_host_ok;
+
+// Request ids of the sessions do not overlap, so a response on the wrong one shows.
+static bool host_pipeline_rounds(struct host *host) {
+    const uint32_t first_id = 10000 * (host->session + 1);
+
+    for (int i = 0; i < SESSION_ROUNDS; i++) {
+        if (!host_pipeline(host, first_id + i * PIPELINE_DEPTH)) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+static void second_host_main(void *p1, void *p2, void *p3) {
+    second_host_ok = host_pipeline_rounds(p1);
+}
+
+static bool host_rx_frames(struct host *host, uint32_t *rx_frames) {
+    bridge_Request req = bridge_Request_init_zero;
+    bridge_Response resp;
+
+    req.get_link_stats = true;
+    if (!host_send(host, &req) || !host_receive(host, &resp) || !resp.has_link_stats) {
+        return false;
+    }
+
+    *rx_frames = resp.link_stats.rx_frames;
+    return true;
+}
+
+ZTEST_SUITE(bridge_loopback, NULL, NULL, NULL, NULL, NULL);
+
+ZTEST(bridge_loopback, test_round_trip) {
+    struct host host;
+    bridge_Response resp;
+
+    host_init(&host, 0);
+
+    bridge_Request req = bridge_Request_init_zero;
+    req.request_id = 1;
+    req.get_bridge_info = true;
+
+    zassert_true(host_send(&host, &req));
+    zassert_true(host_receive(&host, &resp));
+    zassert_equal(resp.request_id, 1);
+    zassert_true(resp.request_status);
+    zassert_true(resp.has_bridge_info);
+    zassert_equal(resp.bridge_info.framing_codecs & BIT(bridge_FramingCodec_FRAMING_CODEC_ESCAPE),
+                  BIT(bridge_FramingCodec_FRAMING_CODEC_ESCAPE));
+
+    req = device_info_request(2);
+    zassert_true(host_send(&host, &req));
+    zassert_true(host_receive(&host, &resp));
+    zassert_equal(resp.request_id, 2);
+    zassert_true(resp.request_status);
+    zassert_equal(resp.which_subsystem, bridge_Response_core_tag);
+    zassert_equal(resp.subsystem.core.which_response_type,
+                  bridge_core_Response_get_device_info_tag);
+}
+
+ZTEST(bridge_loopback, test_pipelined_requests) {
+    struct host host;
+
+    host_init(&host, 0);
+    zassert_true(host_pipeline(&host, 100));
+    // Once more, after the Bridge has gone idle.
+    zassert_true(host_pipeline(&host, 200));
+}
+
+ZTEST(bridge_loopback, test_batch) {
+    struct host host;
+    bridge_Response resp;
+
+    host_init(&host, 0);
+
+    bridge_Request link_stats = bridge_Request_init_zero;
+    link_stats.get_link_stats = true;
+    const bridge_Request items[] = {device_info_request(0), link_stats};
+    const struct batch_items batch = {items, ARRAY_SIZE(items)};
+
+    bridge_Request req = batch_request(400, &batch, false);
+    zassert_true(host_send(&host, &req));
+    zassert_true(host_receive(&host, &resp));
+    zassert_equal(resp.request_id, 400);
+    zassert_true(resp.request_status);
+    zassert_true(resp.has_batch);
+    zassert_equal(resp.batch.executed, 2);
+    zassert_equal(resp.batch.status_bitmap, 0b11);
+}
+
+ZTEST(bridge_loopback, test_concurrent_sessions) {
+    struct host hosts[2];
+    uint32_t before[ARRAY_SIZE(hosts)];
+    uint32_t after[ARRAY_SIZE(hosts)];
+
+    for (int i = 0; i < ARRAY_SIZE(hosts); i++) {
+        host_init(&hosts[i], i);
+        zassert_true(host_rx_frames(&hosts[i], &before[i]));
+    }
+
+    k_thread_create(&second_host_thread, second_host_stack,
+                    K_THREAD_STACK_SIZEOF(second_host_stack), second_host_main, &hosts[1], NULL,
+                    NULL, k_thread_priority_get(k_current_get()), 0, K_NO_WAIT);
+    const bool first_host_ok = host_pipeline_rounds(&hosts[0]);
+    zassert_ok(k_thread_join(&second_host_thread, K_SECONDS(10)));
+
+    zassert_true(first_host_ok);
+    zassert_true(second_host_ok);
+
+    // Each link counted its own frames only, including the request for the counter.
+    for (int i = 0; i < ARRAY_SIZE(hosts); i++) {
+        zassert_true(host_rx_frames(&hosts[i], &after[i]));
+        zassert_equal(after[i] - before[i], SESSION_ROUNDS * PIPELINE_DEPTH + 1, "Session %d", i);
+    }
+}
+
+ZTEST(bridge_loopback, test_no_such_session) {
+    const uint8_t byte = 0;
+    uint8_t buf[1];
+
+    zassert_equal(bridge_loopback_send(CONFIG_ZMK_BRIDGE_LOOPBACK_SESSIONS, &byte, 1, K_NO_WAIT),
+                  -EINVAL);
+    zassert_equal(
+        bridge_loopback_receive(CONFIG_ZMK_BRIDGE_LOOPBACK_SESSIONS, buf, sizeof(buf), K_NO_WAIT),
+        0);
+}
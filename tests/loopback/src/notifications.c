@@ -0,0 +1,156 @@
+/*
+ * Copyright (c) 2025 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+/*
+ * Notifications queued with bridge_notify(), told apart by their base_time_ms. The scheduler is
+ * locked while several are queued, so the Bridge sees them all at once, as it would after being
+ * busy for a while.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+#include <pb_encode.h>
+
+#include "host.h"
+
+static struct host host;
+
+static bridge_Notification test_notification(uint32_t id) {
+    return BRIDGE_NOTIFICATION(events, batch, {.base_time_ms = id});
+}
+
+static void expect_notification(uint32_t id) {
+    bridge_Response resp = bridge_Response_init_zero;
+
+    zassert_true(host_receive_frame(&host, &resp, HOST_TIMEOUT), "No notification %d", id);
+    zassert_true(resp.has_notification, "Got a response instead of notification %d", id);
+    zassert_equal(resp.notification.which_subsystem, bridge_Notification_events_tag);
+    zassert_equal(resp.notification.subsystem.events.notification_type.batch.base_time_ms, id);
+}
+
+static void expect_quiet(void) {
+    bridge_Response resp = bridge_Response_init_zero;
+
+    zassert_false(host_receive_frame(&host, &resp, K_MSEC(50)), "More than was queued");
+}
+
+// Fills the queue for priority, counting from first_id, then tries one more.
+static void fill_queue(enum bridge_notification_priority priority, int size, uint32_t first_id) {
+    int queued = 0;
+
+    k_sched_lock();
+    for (int i = 0; i < size; i++) {
+        const bridge_Notification notification = test_notification(first_id + i);
+        queued += bridge_notify(&notification, priority) == 0;
+    }
+
+    const bridge_Notification notification = test_notification(first_id + size);
+    const int ret = bridge_notify(&notification, priority);
+    k_sched_unlock();
+
+    zassert_equal(queued, size);
+    zassert_equal(ret, -EAGAIN);
+}
+
+static bool encode_too_many_events(pb_ostream_t *stream, const pb_field_t *field,
+                                   void *const *arg) {
+    // Five bytes each with their tag, more than fit.
+    for (uint32_t i = 0; i < CONFIG_ZMK_BRIDGE_NOTIFICATION_MAX_SIZE / 5 + 1; i++) {
+        if (!pb_encode_tag_for_field(stream, field) || !pb_encode_fixed32(stream, &i)) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+static void notifications_before(void *fixture) {
+    host_init(&host, 0);
+    host_drain(&host, K_MSEC(10));
+}
+
+// Every session got the notifications, the second one has to be read too.
+static void notifications_after(void *fixture) {
+    struct host other;
+
+    host_init(&other, 1);
+    host_drain(&other, K_MSEC(10));
+}
+
+ZTEST_SUITE(bridge_notifications, NULL, NULL, notifications_before, notifications_after, NULL);
+
+ZTEST(bridge_notifications, test_high_priority_first) {
+    const bridge_Notification low_1 = test_notification(1);
+    const bridge_Notification low_2 = test_notification(2);
+    const bridge_Notification high = test_notification(3);
+
+    k_sched_lock();
+    const int ret = bridge_notify(&low_1, BRIDGE_NOTIFICATION_PRIORITY_LOW) ||
+                    bridge_notify(&low_2, BRIDGE_NOTIFICATION_PRIORITY_LOW) ||
+                    bridge_notify(&high, BRIDGE_NOTIFICATION_PRIORITY_HIGH);
+    k_sched_unlock();
+
+    zassert_ok(ret);
+    expect_notification(3);
+    expect_notification(1);
+    expect_notification(2);
+    expect_quiet();
+}
+
+ZTEST(bridge_notifications, test_high_priority_between_chunks) {
+    bridge_Response resp = bridge_Response_init_zero;
+    bridge_Request req = bridge_Request_init_zero;
+
+    req.request_id = 800;
+    req.has_read_chunks = true;
+    req.read_chunks.blob_id = bridge_BlobId_BLOB_ID_BRIDGE_SOURCE;
+    req.read_chunks.chunk_size = 100;
+    req.read_chunks.window = 2;
+    zassert_true(host_send(&host, &req));
+
+    // The first chunk does not fit in the TX buffer, the Bridge waits for it to be read.
+    k_sleep(K_MSEC(10));
+    const bridge_Notification high = test_notification(4);
+    zassert_ok(bridge_notify(&high, BRIDGE_NOTIFICATION_PRIORITY_HIGH));
+
+    zassert_true(host_receive_frame(&host, &resp, HOST_TIMEOUT));
+    zassert_true(resp.has_chunk);
+    zassert_equal(resp.chunk.offset, 0);
+
+    expect_notification(4);
+
+    resp = (bridge_Response)bridge_Response_init_zero;
+    zassert_true(host_receive_frame(&host, &resp, HOST_TIMEOUT));
+    zassert_true(resp.has_chunk);
+    zassert_equal(resp.chunk.offset, 100);
+    expect_quiet();
+}
+
+ZTEST(bridge_notifications, test_full_queues) {
+    // The notification that did not fit is dropped, the queued ones arrive in order.
+    fill_queue(BRIDGE_NOTIFICATION_PRIORITY_LOW, CONFIG_ZMK_BRIDGE_NOTIFICATION_LOW_QUEUE_SIZE,
+               100);
+    for (int i = 0; i < CONFIG_ZMK_BRIDGE_NOTIFICATION_LOW_QUEUE_SIZE; i++) {
+        expect_notification(100 + i);
+    }
+    expect_quiet();
+
+    fill_queue(BRIDGE_NOTIFICATION_PRIORITY_HIGH, CONFIG_ZMK_BRIDGE_NOTIFICATION_HIGH_QUEUE_SIZE,
+               200);
+    for (int i = 0; i < CONFIG_ZMK_BRIDGE_NOTIFICATION_HIGH_QUEUE_SIZE; i++) {
+        expect_notification(200 + i);
+    }
+    expect_quiet();
+}
+
+ZTEST(bridge_notifications, test_too_large) {
+    bridge_Notification notification = test_notification(5);
+    notification.subsystem.events.notification_type.batch.events.funcs.encode =
+        encode_too_many_events;
+
+    zassert_equal(bridge_notify(&notification, BRIDGE_NOTIFICATION_PRIORITY_LOW), -ENOMEM);
+    expect_quiet();
+}
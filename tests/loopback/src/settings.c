@@ -0,0 +1,194 @@
+/*
+ * Copyright (c) 2025 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+/*
+ * When Bridge settings get written, seen from a settings backend that records every write of the
+ * test setting and its uptime. prj.conf shortens the debounce and the maximum delay, so the tests
+ * wait for them in full.
+ */
+
+#include <string.h>
+
+#include <zephyr/kernel.h>
+#include <zephyr/settings/settings.h>
+#include <zephyr/ztest.h>
+
+#include <bridge_settings.h>
+
+#include "host.h"
+
+#define DEBOUNCE CONFIG_ZMK_BRIDGE_SETTINGS_SAVE_DEBOUNCE
+#define MAX_DELAY CONFIG_ZMK_BRIDGE_SETTINGS_SAVE_MAX_DELAY
+// The save work runs on the system work queue, a little after its timeout.
+#define SLACK 10
+
+BUILD_ASSERT(MAX_DELAY > 2 * DEBOUNCE, "The tests need a maximum delay of several debounces");
+
+BRIDGE_SETTING_DEFINE(test_setting, "test/value", uint32_t, NULL, 0);
+
+struct recorded_save {
+    int64_t uptime;
+    uint32_t value;
+    // 0 for a delete.
+    size_t len;
+};
+
+static struct recorded_save saves[16];
+static atomic_t save_count;
+static K_SEM_DEFINE(save_sem, 0, ARRAY_SIZE(saves));
+
+static struct host host;
+
+static int recording_load(struct settings_store *cs, const struct settings_load_arg *arg) {
+    return 0;
+}
+
+static int recording_save(struct settings_store *cs, const char *name, const char *value,
+                          size_t val_len) {
+    if (strcmp(name, "bridge/test/value") != 0) {
+        return 0;
+    }
+
+    const atomic_val_t i = atomic_inc(&save_count);
+    if (i < ARRAY_SIZE(saves)) {
+        saves[i].uptime = k_uptime_get();
+        saves[i].len = val_len;
+        saves[i].value = 0;
+        if (value && val_len == sizeof(saves[i].value)) {
+            memcpy(&saves[i].value, value, val_len);
+        }
+    }
+
+    k_sem_give(&save_sem);
+    return 0;
+}
+
+static const struct settings_store_itf recording_itf = {
+    .csi_load = recording_load,
+    .csi_save = recording_save,
+};
+
+static struct settings_store recording_store = {.cs_itf = &recording_itf};
+
+// The backend of CONFIG_SETTINGS_CUSTOM.
+int settings_backend_init(void) {
+    settings_dst_register(&recording_store);
+    settings_src_register(&recording_store);
+    return 0;
+}
+
+static void set_value(uint32_t value) { bridge_settings_set(&test_setting, &value); }
+
+static const struct recorded_save *wait_for_save(k_timeout_t timeout) {
+    if (k_sem_take(&save_sem, timeout) < 0) {
+        return NULL;
+    }
+
+    const atomic_val_t i = atomic_get(&save_count) - 1;
+    return i < ARRAY_SIZE(saves) ? &saves[i] : NULL;
+}
+
+static void *settings_setup(void) {
+    zassert_ok(settings_subsys_init());
+    return NULL;
+}
+
+static void settings_before(void *fixture) {
+    host_init(&host, 0);
+    host_drain(&host, K_MSEC(10));
+    atomic_clear(&save_count);
+    k_sem_reset(&save_sem);
+}
+
+ZTEST_SUITE(bridge_settings, NULL, settings_setup, settings_before, NULL, NULL);
+
+ZTEST(bridge_settings, test_debounce) {
+    const int64_t start = k_uptime_get();
+
+    set_value(1);
+    zassert_is_null(wait_for_save(K_MSEC(DEBOUNCE - SLACK)), "Saved before the debounce");
+
+    const struct recorded_save *save = wait_for_save(K_MSEC(2 * SLACK));
+    zassert_not_null(save);
+    zassert_equal(save->value, 1);
+    zassert_true(save->uptime - start >= DEBOUNCE);
+}
+
+ZTEST(bridge_settings, test_burst) {
+    const uint32_t values[] = {2, 3, 4};
+    int64_t last_change = 0;
+
+    for (int i = 0; i < ARRAY_SIZE(values); i++) {
+        set_value(values[i]);
+        last_change = k_uptime_get();
+        zassert_is_null(wait_for_save(K_MSEC(DEBOUNCE / 2)));
+    }
+
+    // One write, of the last value, a debounce after it was set.
+    const struct recorded_save *save = wait_for_save(K_MSEC(DEBOUNCE));
+    zassert_not_null(save);
+    zassert_equal(save->value, values[ARRAY_SIZE(values) - 1]);
+    zassert_true(save->uptime - last_change >= DEBOUNCE);
+    zassert_is_null(wait_for_save(K_MSEC(DEBOUNCE)));
+    zassert_equal(atomic_get(&save_count), 1);
+}
+
+ZTEST(bridge_settings, test_max_delay) {
+    const int64_t start = k_uptime_get();
+    uint32_t value = 100;
+
+    // Changes keep coming faster than the debounce, for twice the maximum delay.
+    while (k_uptime_get() - start < 2 * MAX_DELAY) {
+        set_value(++value);
+        k_sleep(K_MSEC(DEBOUNCE / 2));
+    }
+
+    zassert_true(atomic_get(&save_count) >= 1, "Never saved while changes kept coming");
+    const struct recorded_save *first = &saves[0];
+    zassert_between_inclusive(first->uptime - start, MAX_DELAY, MAX_DELAY + SLACK);
+
+    // Once they stop, the last value is written after a debounce.
+    k_sleep(K_MSEC(DEBOUNCE + SLACK));
+    const atomic_val_t count = atomic_get(&save_count);
+    zassert_true(count >= 2 && count <= ARRAY_SIZE(saves));
+    zassert_equal(saves[count - 1].value, value);
+    k_sem_reset(&save_sem);
+}
+
+ZTEST(bridge_settings, test_unchanged) {
+    set_value(5);
+    zassert_not_null(wait_for_save(K_MSEC(DEBOUNCE + SLACK)));
+
+    set_value(5);
+    zassert_is_null(wait_for_save(K_MSEC(DEBOUNCE + SLACK)), "Saved an unchanged value");
+}
+
+ZTEST(bridge_settings, test_reset_over_loopback) {
+    bridge_Request req = bridge_Request_init_zero;
+    bridge_Response resp;
+
+    // Reset before the change is written, so it never is.
+    set_value(7);
+
+    req.request_id = 1300;
+    req.which_subsystem = bridge_Request_core_tag;
+    req.subsystem.core.which_request_type = bridge_core_Request_reset_settings_tag;
+    req.subsystem.core.request_type.reset_settings = true;
+    zassert_true(host_send(&host, &req));
+    zassert_true(host_receive(&host, &resp));
+    zassert_equal(resp.request_id, 1300);
+    zassert_true(resp.request_status);
+    zassert_equal(test_setting_value, 0);
+
+    const struct recorded_save *save = wait_for_save(K_MSEC(DEBOUNCE + SLACK));
+    zassert_not_null(save);
+    zassert_equal(save->len, 0, "Not deleted");
+    zassert_is_null(wait_for_save(K_MSEC(DEBOUNCE + SLACK)));
+
+    // Back at the default, which is not written again.
+    set_value(0);
+    zassert_is_null(wait_for_save(K_MSEC(DEBOUNCE + SLACK)));
+}
@@ -0,0 +1,117 @@
+/*
+ * Copyright (c) 2025 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+/*
+ * Telemetry of session 0. The scheduler is locked while the host fills the frame buffers or a
+ * notification queue, so the Bridge gets to none of it before the peak is reached.
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+
+#include "host.h"
+
+static struct host host;
+
+static void telemetry(bridge_Telemetry *telemetry) {
+    bridge_Request req = bridge_Request_init_zero;
+    bridge_Response resp;
+
+    req.get_telemetry = true;
+    zassert_true(host_send(&host, &req));
+    zassert_true(host_receive(&host, &resp));
+    zassert_true(resp.has_telemetry);
+    zassert_true(resp.telemetry.has_link_stats);
+    *telemetry = resp.telemetry;
+}
+
+static void telemetry_before(void *fixture) {
+    host_init(&host, 0);
+    host_drain(&host, K_MSEC(10));
+}
+
+static void telemetry_after(void *fixture) {
+    struct host other;
+
+    host_init(&other, 1);
+    host_drain(&other, K_MSEC(10));
+}
+
+ZTEST_SUITE(bridge_telemetry, NULL, NULL, telemetry_before, telemetry_after, NULL);
+
+ZTEST(bridge_telemetry, test_stacks) {
+    bridge_Telemetry sample;
+
+    telemetry(&sample);
+    zassert_equal(sample.tx_buf_size, CONFIG_ZMK_BRIDGE_TX_BUF_SIZE);
+    zassert_equal(sample.rx_frame_count, CONFIG_ZMK_BRIDGE_RX_FRAME_COUNT);
+    zassert_true(sample.tx_buf_peak > 0 && sample.tx_buf_peak <= sample.tx_buf_size);
+
+    // The workers and the async work queue, the loopback has no RX thread.
+    zassert_equal(sample.stacks_count, CONFIG_ZMK_BRIDGE_WORKER_COUNT + 1);
+    for (int i = 0; i < sample.stacks_count; i++) {
+        const bridge_StackUsage *stack = &sample.stacks[i];
+        char name[sizeof(stack->name)];
+
+        if (i < CONFIG_ZMK_BRIDGE_WORKER_COUNT) {
+            snprintf(name, sizeof(name), "bridge_worker_%d", i);
+        } else {
+            strcpy(name, "bridge_async");
+        }
+
+        zassert_str_equal(stack->name, name);
+        // Threads of native_sim run on their own host stacks, so only the size is sure to be set.
+        zassert_true(stack->size > 0 && stack->peak_used <= stack->size, "%s", name);
+    }
+}
+
+ZTEST(bridge_telemetry, test_rx_frames_peak) {
+    bridge_Telemetry sample;
+    bool sent = true;
+
+    k_sched_lock();
+    for (int i = 0; i < CONFIG_ZMK_BRIDGE_RX_FRAME_COUNT; i++) {
+        const bridge_Request req = device_info_request(1200 + i);
+        sent = sent && host_send(&host, &req);
+    }
+    k_sched_unlock();
+
+    zassert_true(sent);
+    for (int i = 0; i < CONFIG_ZMK_BRIDGE_RX_FRAME_COUNT; i++) {
+        bridge_Response resp;
+        zassert_true(host_receive(&host, &resp));
+        zassert_equal(resp.request_id, 1200 + i);
+    }
+
+    telemetry(&sample);
+    zassert_equal(sample.rx_frames_peak, CONFIG_ZMK_BRIDGE_RX_FRAME_COUNT);
+}
+
+ZTEST(bridge_telemetry, test_notifications_dropped) {
+    bridge_Telemetry before, after;
+    int queued = 0;
+
+    telemetry(&before);
+
+    k_sched_lock();
+    for (int i = 0; i <= CONFIG_ZMK_BRIDGE_NOTIFICATION_LOW_QUEUE_SIZE; i++) {
+        const bridge_Notification notification =
+            BRIDGE_NOTIFICATION(events, batch, {.base_time_ms = i});
+        queued += bridge_notify(&notification, BRIDGE_NOTIFICATION_PRIORITY_LOW) == 0;
+    }
+    k_sched_unlock();
+
+    zassert_equal(queued, CONFIG_ZMK_BRIDGE_NOTIFICATION_LOW_QUEUE_SIZE);
+
+    // The notifications come first, host_receive() skips them.
+    telemetry(&after);
+    zassert_equal(after.notifications_dropped - before.notifications_dropped, 1);
+    zassert_equal(after.notification_low_peak, CONFIG_ZMK_BRIDGE_NOTIFICATION_LOW_QUEUE_SIZE);
+    zassert_equal(after.encode_failures, before.encode_failures);
+}
@@ -0,0 +1,383 @@
+/*
+ * Copyright (c) 2025 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+/*
+ * The underglow subsystem driving the LED strip and the rgb_ug behavior of subsystems.overlay.
+ * Neither has a real driver here: the strip records the frames it is shown, the behavior the
+ * colors it is tapped with.
+ */
+
+#include <zephyr/device.h>
+#include <zephyr/devicetree.h>
+#include <zephyr/drivers/led_strip.h>
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+#include <pb_encode.h>
+
+#include <dt-bindings/zmk/rgb.h>
+#include <zmk/behavior.h>
+
+#include "host.h"
+
+#define DT_DRV_COMPAT zmk_bridge_test_led_strip
+
+#define STRIP_LEN DT_INST_PROP(0, chain_length)
+#define STRIP_BYTES (STRIP_LEN * 3)
+
+#define FRAME_RATE 60
+#define FRAME_COUNT 60
+
+#define RED RGB_COLOR_HSB_VAL(0, 100, 100)
+#define BLUE RGB_COLOR_HSB_VAL(240, 100, 100)
+
+static struct host host;
+
+static struct led_rgb strip_shown[STRIP_LEN];
+static uint32_t strip_updates;
+static int64_t strip_updated_ticks;
+static K_SEM_DEFINE(strip_updated, 0, 1);
+
+static int test_strip_update_rgb(const struct device *dev, struct led_rgb *pixels,
+                                 size_t num_pixels) {
+    memcpy(strip_shown, pixels, MIN(num_pixels, STRIP_LEN) * sizeof(pixels[0]));
+    strip_updated_ticks = k_uptime_ticks();
+    strip_updates++;
+    k_sem_give(&strip_updated);
+    return 0;
+}
+
+static int test_strip_update_channels(const struct device *dev, uint8_t *channels,
+                                      size_t num_channels) {
+    return -ENOTSUP;
+}
+
+static const struct led_strip_driver_api test_strip_api = {
+    .update_rgb = test_strip_update_rgb,
+    .update_channels = test_strip_update_channels,
+};
+
+DEVICE_DT_INST_DEFINE(0, NULL, NULL, NULL, NULL, POST_KERNEL, CONFIG_KERNEL_INIT_PRIORITY_DEVICE,
+                      &test_strip_api);
+
+// Only has to be ready, zmk_behavior_invoke_binding() below never looks at it.
+DEVICE_DT_DEFINE(DT_NODELABEL(rgb_ug), NULL, NULL, NULL, NULL, POST_KERNEL,
+                 CONFIG_KERNEL_INIT_PRIORITY_DEVICE, NULL);
+
+struct tap {
+    // As RGB_COLOR_HSB_VAL() packs it.
+    uint32_t color;
+    int64_t uptime_ms;
+};
+
+K_MSGQ_DEFINE(color_taps, sizeof(struct tap), 16, 8);
+
+int zmk_behavior_invoke_binding(const struct zmk_behavior_binding *src_binding,
+                                struct zmk_behavior_binding_event event, bool pressed) {
+    if (pressed && src_binding->param1 == RGB_COLOR_HSB_CMD) {
+        const struct tap tap = {src_binding->param2, k_uptime_get()};
+        k_msgq_put(&color_taps, &tap, K_NO_WAIT);
+    }
+
+    return 0;
+}
+
+static void expect_tap(struct tap *tap) {
+    zassert_ok(k_msgq_get(&color_taps, tap, HOST_TIMEOUT), "rgb_ug was not tapped");
+}
+
+static void expect_color_tap(uint32_t color, int64_t *uptime_ms) {
+    struct tap tap;
+
+    expect_tap(&tap);
+    zassert_equal(tap.color, color, "Tapped with 0x%06x", tap.color);
+    *uptime_ms = tap.uptime_ms;
+}
+
+// Nothing is tapped once what was already on the underglow work queue is through.
+static void expect_no_taps(void) {
+    struct tap tap;
+
+    k_sleep(K_MSEC(10));
+    k_msgq_purge(&color_taps);
+    zassert_equal(k_msgq_get(&color_taps, &tap, K_MSEC(100)), -ENOMSG);
+}
+
+struct pixel_data {
+    const uint8_t *data;
+    size_t len;
+};
+
+static bool encode_pixel_data(pb_ostream_t *stream, const pb_field_t *field, void *const *arg) {
+    const struct pixel_data *pixel_data = *arg;
+
+    return pb_encode_tag_for_field(stream, field) &&
+           pb_encode_string(stream, pixel_data->data, pixel_data->len);
+}
+
+static void expect_request_status(const bridge_Request *req, bool status) {
+    bridge_Response resp;
+
+    zassert_true(host_send(&host, req));
+    zassert_true(host_receive(&host, &resp));
+    zassert_equal(resp.request_id, req->request_id);
+    zassert_equal(resp.request_status, status, "Request %d", req->request_id);
+}
+
+static void set_pixels(uint32_t request_id, uint32_t offset, const uint8_t *data, size_t len,
+                       bool commit, bool status) {
+    const struct pixel_data pixel_data = {data, len};
+    bridge_Request req = bridge_Request_init_zero;
+
+    req.request_id = request_id;
+    req.which_subsystem = bridge_Request_underglow_tag;
+    req.subsystem.underglow.which_request_type = bridge_underglow_Request_set_pixels_tag;
+    req.subsystem.underglow.request_type.set_pixels.commit = commit;
+    req.subsystem.underglow.request_type.set_pixels.offset = offset;
+    req.subsystem.underglow.request_type.set_pixels.data.funcs.encode = encode_pixel_data;
+    req.subsystem.underglow.request_type.set_pixels.data.arg = (void *)&pixel_data;
+    expect_request_status(&req, status);
+}
+
+struct keyframes {
+    const bridge_underglow_Keyframe *keyframes;
+    size_t len;
+};
+
+static bool encode_keyframes(pb_ostream_t *stream, const pb_field_t *field, void *const *arg) {
+    const struct keyframes *keyframes = *arg;
+
+    for (size_t i = 0; i < keyframes->len; i++) {
+        if (!pb_encode_tag_for_field(stream, field) ||
+            !pb_encode_submessage(stream, bridge_underglow_Keyframe_fields,
+                                  &keyframes->keyframes[i])) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+static bridge_Request upload_animation_request(uint32_t request_id,
+                                               const struct keyframes *keyframes,
+                                               uint32_t loop_count) {
+    bridge_Request req = bridge_Request_init_zero;
+    bridge_underglow_Animation *upload = &req.subsystem.underglow.request_type.upload_animation;
+
+    req.request_id = request_id;
+    req.which_subsystem = bridge_Request_underglow_tag;
+    req.subsystem.underglow.which_request_type = bridge_underglow_Request_upload_animation_tag;
+    upload->keyframes.funcs.encode = encode_keyframes;
+    upload->keyframes.arg = (void *)keyframes;
+    upload->loop_count = loop_count;
+    return req;
+}
+
+static void control_animation(uint32_t request_id, bridge_underglow_AnimationControl control,
+                              bool status) {
+    bridge_Request req = bridge_Request_init_zero;
+
+    req.request_id = request_id;
+    req.which_subsystem = bridge_Request_underglow_tag;
+    req.subsystem.underglow.which_request_type = bridge_underglow_Request_control_animation_tag;
+    req.subsystem.underglow.request_type.control_animation = control;
+    expect_request_status(&req, status);
+}
+
+// What the strip shows, as r, g, b triplets.
+static void expect_strip(const uint8_t *expected) {
+    for (int i = 0; i < STRIP_LEN; i++) {
+        const uint8_t *rgb = &expected[i * 3];
+        zassert_true(strip_shown[i].r == rgb[0] && strip_shown[i].g == rgb[1] &&
+                         strip_shown[i].b == rgb[2],
+                     "Pixel %d", i);
+    }
+}
+
+static void fill_frame(uint8_t *frame, int n) {
+    for (int i = 0; i < STRIP_BYTES; i++) {
+        frame[i] = (n * 7 + i * 3) & 0xff;
+    }
+}
+
+static void underglow_before(void *fixture) {
+    host_init(&host, 0);
+    host_drain(&host, K_MSEC(10));
+    k_sem_reset(&strip_updated);
+    k_msgq_purge(&color_taps);
+}
+
+ZTEST_SUITE(bridge_underglow, NULL, NULL, underglow_before, NULL, NULL);
+
+ZTEST(bridge_underglow, test_stream_frames) {
+    static uint8_t frame[STRIP_BYTES];
+    const uint32_t updates = strip_updates;
+    uint32_t latency_max_us = 0;
+    const int64_t start = k_uptime_get();
+
+    for (int i = 0; i < FRAME_COUNT; i++) {
+        const int64_t deadline = start + (i + 1) * MSEC_PER_SEC / FRAME_RATE;
+
+        fill_frame(frame, i);
+        k_sem_reset(&strip_updated);
+        const int64_t sent_ticks = k_uptime_ticks();
+        set_pixels(1000 + i, 0, frame, sizeof(frame), true, true);
+
+        // Every frame is shown, exactly as sent, before the next one is due.
+        zassert_ok(k_sem_take(&strip_updated, K_TIMEOUT_ABS_MS(deadline)), "Frame %d late", i);
+        expect_strip(frame);
+        latency_max_us =
+            MAX(latency_max_us, k_ticks_to_us_ceil32(strip_updated_ticks - sent_ticks));
+
+        k_sleep(K_TIMEOUT_ABS_MS(deadline));
+    }
+
+    const int64_t elapsed = k_uptime_get() - start;
+    TC_PRINT("%d frames of %d pixels in %d ms, %d FPS, shown within %u us\n", FRAME_COUNT,
+             STRIP_LEN, (int)elapsed, (int)(FRAME_COUNT * MSEC_PER_SEC / elapsed), latency_max_us);
+    zassert_equal(strip_updates - updates, FRAME_COUNT);
+}
+
+ZTEST(bridge_underglow, test_partial_update) {
+    static uint8_t frame[STRIP_BYTES];
+    const uint8_t patch[5 * 3] = {[0 ... 14] = 0xa5};
+
+    fill_frame(frame, 100);
+    set_pixels(1100, 0, frame, sizeof(frame), true, true);
+    zassert_ok(k_sem_take(&strip_updated, HOST_TIMEOUT));
+    expect_strip(frame);
+
+    // Nothing is shown until a commit, which then builds on the frame shown before.
+    set_pixels(1101, 10, patch, sizeof(patch), false, true);
+    zassert_equal(k_sem_take(&strip_updated, K_MSEC(50)), -EAGAIN);
+    expect_strip(frame);
+
+    set_pixels(1102, 0, NULL, 0, true, true);
+    zassert_ok(k_sem_take(&strip_updated, HOST_TIMEOUT));
+    memcpy(&frame[10 * 3], patch, sizeof(patch));
+    expect_strip(frame);
+}
+
+ZTEST(bridge_underglow, test_pixels_out_of_range) {
+    static uint8_t frame[STRIP_BYTES + 3];
+    const uint32_t updates = strip_updates;
+
+    fill_frame(frame, 200);
+
+    // Past the end of the strip, one pixel too many, and a partial pixel.
+    set_pixels(1200, STRIP_LEN - 4, frame, 5 * 3, true, false);
+    set_pixels(1201, 0, frame, sizeof(frame), true, false);
+    set_pixels(1202, 0, frame, 4, true, false);
+
+    zassert_equal(k_sem_take(&strip_updated, K_MSEC(50)), -EAGAIN);
+    zassert_equal(strip_updates, updates);
+}
+
+// Runs ahead of the other animation tests, ztest runs them in order of their names.
+ZTEST(bridge_underglow, test_animation_before_upload) {
+    bridge_Response resp = bridge_Response_init_zero;
+    bridge_underglow_Keyframe too_many[CONFIG_ZMK_BRIDGE_UNDERGLOW_ANIMATION_MAX_KEYFRAMES + 1];
+    const bridge_underglow_Keyframe instant = {.has_color = true, .color = {0, 100, 100}};
+    const struct keyframes none = {NULL, 0};
+    const struct keyframes zero_duration = {&instant, 1};
+
+    control_animation(1300, bridge_underglow_AnimationControl_ANIMATION_PLAY, false);
+
+    // None of the rejected uploads leaves an animation to play.
+    bridge_Request req = upload_animation_request(1301, &none, 1);
+    expect_request_status(&req, false);
+    req = upload_animation_request(1302, &zero_duration, 1);
+    expect_request_status(&req, false);
+    control_animation(1303, bridge_underglow_AnimationControl_ANIMATION_PLAY, false);
+
+    // Only durations, so the keyframes still fit in a frame.
+    for (int i = 0; i < ARRAY_SIZE(too_many); i++) {
+        too_many[i] = (bridge_underglow_Keyframe){.duration_ms = 10};
+    }
+    const struct keyframes too_many_keyframes = {too_many, ARRAY_SIZE(too_many)};
+    req = upload_animation_request(1304, &too_many_keyframes, 1);
+    zassert_true(host_send(&host, &req));
+    zassert_true(host_receive_frame(&host, &resp, HOST_TIMEOUT));
+    zassert_true(resp.has_nak);
+    zassert_equal(resp.nak.reason, bridge_NakReason_NAK_REASON_DECODE_FAILED);
+    control_animation(1305, bridge_underglow_AnimationControl_ANIMATION_PLAY, false);
+
+    // Keyframes are staged data, which batches do not take.
+    const struct keyframes one = {too_many, 1};
+    const bridge_Request items[] = {upload_animation_request(0, &one, 1)};
+    const struct batch_items batch = {items, ARRAY_SIZE(items)};
+    req = batch_request(1306, &batch, false);
+    zassert_true(host_send(&host, &req));
+    zassert_true(host_receive(&host, &resp));
+    zassert_equal(resp.request_id, 1306);
+    zassert_false(resp.request_status);
+    zassert_equal(resp.batch.executed, 1);
+    zassert_equal(resp.batch.status_bitmap, 0);
+    control_animation(1307, bridge_underglow_AnimationControl_ANIMATION_PLAY, false);
+
+    expect_no_taps();
+}
+
+ZTEST(bridge_underglow, test_animation_loop) {
+    const bridge_underglow_Keyframe keyframes[] = {
+        {.has_color = true,
+         .color = {240, 100, 100},
+         .duration_ms = 100,
+         .easing = bridge_underglow_Easing_EASING_STEP},
+        {.has_color = true,
+         .color = {0, 100, 100},
+         .duration_ms = 100,
+         .easing = bridge_underglow_Easing_EASING_STEP},
+    };
+    const struct keyframes animation = {keyframes, ARRAY_SIZE(keyframes)};
+    int64_t first_ms, tap_ms, last_ms;
+
+    const bridge_Request req = upload_animation_request(1400, &animation, 1);
+    expect_request_status(&req, true);
+    control_animation(1401, bridge_underglow_AnimationControl_ANIMATION_PLAY, true);
+
+    // A step holds the color it comes from, and the first keyframe comes from the last one.
+    expect_color_tap(RED, &first_ms);
+    expect_color_tap(BLUE, &tap_ms);
+    // After one loop it stops on the last keyframe.
+    expect_color_tap(RED, &last_ms);
+    zassert_true(last_ms - first_ms >= 200 - CONFIG_ZMK_BRIDGE_UNDERGLOW_ANIMATION_FRAME_MS,
+                 "Played for %d ms", (int)(last_ms - first_ms));
+    expect_no_taps();
+}
+
+ZTEST(bridge_underglow, test_animation_controls) {
+    // Brightness fading in and out, so every frame taps a new color.
+    const bridge_underglow_Keyframe keyframes[] = {
+        {.has_color = true, .color = {0, 100, 0}, .duration_ms = 1000},
+        {.has_color = true, .color = {0, 100, 100}, .duration_ms = 1000},
+    };
+    const struct keyframes animation = {keyframes, ARRAY_SIZE(keyframes)};
+    struct tap tap;
+    int64_t tap_ms;
+
+    const bridge_Request req = upload_animation_request(1500, &animation, 0);
+    expect_request_status(&req, true);
+    control_animation(1501, bridge_underglow_AnimationControl_ANIMATION_PLAY, true);
+    expect_color_tap(RED, &tap_ms);
+    k_sleep(K_MSEC(100));
+
+    control_animation(1502, bridge_underglow_AnimationControl_ANIMATION_PAUSE, true);
+    expect_no_taps();
+
+    // Resumes where it was paused, dimmer than at the start.
+    control_animation(1503, bridge_underglow_AnimationControl_ANIMATION_PLAY, true);
+    expect_tap(&tap);
+    zassert_true((tap.color & 0xff) < 100, "Tapped with 0x%06x", tap.color);
+
+    // Stopping rewinds, playing again starts over.
+    control_animation(1504, bridge_underglow_AnimationControl_ANIMATION_STOP, true);
+    expect_no_taps();
+    control_animation(1505, bridge_underglow_AnimationControl_ANIMATION_PLAY, true);
+    expect_color_tap(RED, &tap_ms);
+
+    control_animation(1506, bridge_underglow_AnimationControl_ANIMATION_STOP, true);
+    expect_no_taps();
+}
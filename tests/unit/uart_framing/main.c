@@ -0,0 +1,323 @@
+/*
+ * Copyright (c) 2025 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <zephyr/ztest.h>
+
+#include <uart_framing.h>
+
+#define PAYLOAD_MAX 700
+// Room for escaping every byte, plus the trailer and the framing around it.
+#define WIRE_MAX (2 * (PAYLOAD_MAX + UART_FRAMING_CHECK_LEN) + 2)
+// Largest piece of input or output handed to the codec in one call.
+#define SPLIT_MAX 16
+#define ROUNDS 500
+
+static uint32_t rand_state;
+
+static uint32_t test_rand(void) {
+    // xorshift32, so every run sees the same data.
+    rand_state ^= rand_state << 13;
+    rand_state ^= rand_state >> 17;
+    rand_state ^= rand_state << 5;
+    return rand_state;
+}
+
+static size_t rand_split(void) { return 1 + test_rand() % SPLIT_MAX; }
+
+// Random data with plenty of the bytes that the codecs have to treat specially.
+static void fill_payload(uint8_t *buf, size_t len) {
+    for (size_t i = 0; i < len; i++) {
+        switch (test_rand() % 4) {
+        case 0:
+            buf[i] = FRAMING_SOF + test_rand() % 3;
+            break;
+        case 1:
+            buf[i] = 0;
+            break;
+        default:
+            buf[i] = test_rand();
+            break;
+        }
+    }
+}
+
+// Encodes a whole frame, with a random amount of room for every call.
+static size_t encode_frame(enum uart_framing_codec codec, const uint8_t *in, size_t len,
+                           uint8_t *wire) {
+    struct uart_framing_encoder enc;
+    size_t in_idx = 0;
+    size_t wire_len = 0;
+
+    uart_framing_encoder_init(&enc, codec);
+
+    while (in_idx < len) {
+        size_t consumed;
+        wire_len += uart_framing_encode(&enc, &in[in_idx], len - in_idx, &consumed,
+                                        &wire[wire_len], rand_split());
+        in_idx += consumed;
+    }
+
+    bool done = false;
+    while (!done) {
+        wire_len += uart_framing_encode_end(&enc, &wire[wire_len], rand_split(), &done);
+    }
+
+    return wire_len;
+}
+
+/*
+ * Decodes from wire[*wire_idx] until a frame ends or is aborted, in random pieces. Returns the
+ * number of data bytes written to out, the decoder state tells how the frame ended.
+ */
+static size_t decode_frame(struct uart_framing_decoder *dec, const uint8_t *wire, size_t wire_len,
+                           size_t *wire_idx, uint8_t *out) {
+    size_t out_len = 0;
+
+    while (*wire_idx < wire_len) {
+        const size_t in_len = MIN(rand_split(), wire_len - *wire_idx);
+        size_t consumed;
+
+        out_len += uart_framing_decode(dec, &wire[*wire_idx], in_len, &consumed, &out[out_len],
+                                       rand_split());
+        *wire_idx += consumed;
+
+        if (dec->state == FRAMING_STATE_EOF || dec->state == FRAMING_STATE_ERR) {
+            break;
+        }
+    }
+
+    return out_len;
+}
+
+static void round_trip(enum uart_framing_codec codec) {
+    static uint8_t payload[PAYLOAD_MAX];
+    static uint8_t wire[WIRE_MAX + SPLIT_MAX];
+    static uint8_t decoded[PAYLOAD_MAX + SPLIT_MAX];
+
+    for (int round = 0; round < ROUNDS; round++) {
+        const size_t len = test_rand() % (PAYLOAD_MAX + 1);
+        fill_payload(payload, len);
+
+        const size_t wire_len = encode_frame(codec, payload, len, wire);
+        zassert_true(wire_len <= WIRE_MAX, "Frame of %zu bytes took %zu on the wire", len,
+                     wire_len);
+
+        struct uart_framing_decoder dec;
+        uart_framing_decoder_init(&dec, codec);
+
+        size_t wire_idx = 0;
+        const size_t decoded_len = decode_frame(&dec, wire, wire_len, &wire_idx, decoded);
+
+        zassert_equal(dec.state, FRAMING_STATE_EOF, "Round %d did not end the frame", round);
+        zassert_equal(wire_idx, wire_len, "Round %d stopped early", round);
+        zassert_equal(decoded_len, len, "Round %d decoded %zu of %zu bytes", round, decoded_len,
+                      len);
+        zassert_mem_equal(decoded, payload, len, "Round %d decoded other data", round);
+    }
+}
+
+// Frames sent right after each other, decoded without resetting the decoder in between.
+static void back_to_back(enum uart_framing_codec codec) {
+    static uint8_t payloads[3][PAYLOAD_MAX];
+    static uint8_t wire[3 * WIRE_MAX + SPLIT_MAX];
+    static uint8_t decoded[PAYLOAD_MAX + SPLIT_MAX];
+    size_t lens[3];
+    size_t wire_len = 0;
+
+    for (int i = 0; i < ARRAY_SIZE(payloads); i++) {
+        lens[i] = test_rand() % (PAYLOAD_MAX + 1);
+        fill_payload(payloads[i], lens[i]);
+        wire_len += encode_frame(codec, payloads[i], lens[i], &wire[wire_len]);
+    }
+
+    struct uart_framing_decoder dec;
+    uart_framing_decoder_init(&dec, codec);
+    size_t wire_idx = 0;
+
+    for (int i = 0; i < ARRAY_SIZE(payloads); i++) {
+        const size_t decoded_len = decode_frame(&dec, wire, wire_len, &wire_idx, decoded);
+
+        zassert_equal(dec.state, FRAMING_STATE_EOF, "Frame %d did not end", i);
+        zassert_equal(decoded_len, lens[i], "Frame %d has the wrong length", i);
+        zassert_mem_equal(decoded, payloads[i], lens[i], "Frame %d decoded other data", i);
+    }
+
+    zassert_equal(wire_idx, wire_len);
+}
+
+static void *uart_framing_setup(void) { return NULL; }
+
+static void uart_framing_before(void *fixture) { rand_state = 0x2545F491; }
+
+ZTEST_SUITE(uart_framing, NULL, uart_framing_setup, uart_framing_before, NULL, NULL);
+
+ZTEST(uart_framing, test_escape_round_trip) { round_trip(UART_FRAMING_CODEC_ESCAPE); }
+
+ZTEST(uart_framing, test_escape_wire_format) {
+    const uint8_t payload[] = {0x01, FRAMING_SOF, FRAMING_ESC, FRAMING_EOF, 0x00};
+    const uint8_t expected[] = {FRAMING_SOF, 0x01, FRAMING_ESC, FRAMING_SOF, FRAMING_ESC,
+                                FRAMING_ESC, FRAMING_ESC, FRAMING_EOF, 0x00, FRAMING_EOF};
+    uint8_t wire[WIRE_MAX + SPLIT_MAX];
+
+    const size_t wire_len = encode_frame(UART_FRAMING_CODEC_ESCAPE, payload, sizeof(payload), wire);
+
+    zassert_equal(wire_len, sizeof(expected));
+    zassert_mem_equal(wire, expected, sizeof(expected));
+}
+
+ZTEST(uart_framing, test_escape_back_to_back) { back_to_back(UART_FRAMING_CODEC_ESCAPE); }
+
+ZTEST(uart_framing, test_escape_abort_and_resync) {
+    const uint8_t payload[] = {0x10, 0x20, FRAMING_EOF, 0x30};
+    uint8_t wire[WIRE_MAX + SPLIT_MAX] = {FRAMING_SOF, 0x01, 0x02};
+    uint8_t decoded[PAYLOAD_MAX + SPLIT_MAX];
+    const size_t aborted_len = 3;
+
+    const size_t wire_len =
+        aborted_len + encode_frame(UART_FRAMING_CODEC_ESCAPE, payload, sizeof(payload),
+                                   &wire[aborted_len]);
+
+    struct uart_framing_decoder dec;
+    uart_framing_decoder_init(&dec, UART_FRAMING_CODEC_ESCAPE);
+
+    size_t wire_idx = 0;
+    decode_frame(&dec, wire, wire_len, &wire_idx, decoded);
+
+    // Stopped right after the SOF of the next frame.
+    zassert_equal(dec.state, FRAMING_STATE_ERR);
+    zassert_equal(wire_idx, aborted_len + 1);
+
+    uart_framing_decoder_resync(&dec);
+    const size_t decoded_len = decode_frame(&dec, wire, wire_len, &wire_idx, decoded);
+
+    zassert_equal(dec.state, FRAMING_STATE_EOF);
+    zassert_equal(decoded_len, sizeof(payload));
+    zassert_mem_equal(decoded, payload, sizeof(payload));
+}
+
+#if IS_ENABLED(CONFIG_ZMK_BRIDGE_FRAMING_COBS)
+
+ZTEST(uart_framing, test_cobs_round_trip) { round_trip(UART_FRAMING_CODEC_COBS); }
+
+ZTEST(uart_framing, test_cobs_back_to_back) { back_to_back(UART_FRAMING_CODEC_COBS); }
+
+ZTEST(uart_framing, test_cobs_overhead) {
+    static uint8_t payload[PAYLOAD_MAX];
+    static uint8_t wire[WIRE_MAX + SPLIT_MAX];
+
+    for (int round = 0; round < ROUNDS; round++) {
+        const size_t len = test_rand() % (PAYLOAD_MAX + 1);
+        fill_payload(payload, len);
+
+        const size_t wire_len = encode_frame(UART_FRAMING_CODEC_COBS, payload, len, wire);
+
+        // One code byte per started block of 254 and the delimiter.
+        zassert_true(wire_len <= len + len / 254 + 2, "%zu bytes took %zu", len, wire_len);
+        zassert_equal(wire[wire_len - 1], 0);
+        zassert_is_null(memchr(wire, 0, wire_len - 1), "Zero inside a COBS frame");
+    }
+}
+
+ZTEST(uart_framing, test_cobs_abort_and_resync) {
+    const uint8_t payload[] = {0x00, 0x11, 0x00, 0x00, 0x22};
+    // A block announcing four bytes, cut short by a delimiter.
+    uint8_t wire[WIRE_MAX + SPLIT_MAX] = {0x05, 0x01, 0x02, 0x00};
+    uint8_t decoded[PAYLOAD_MAX + SPLIT_MAX];
+    const size_t aborted_len = 4;
+
+    const size_t wire_len =
+        aborted_len +
+        encode_frame(UART_FRAMING_CODEC_COBS, payload, sizeof(payload), &wire[aborted_len]);
+
+    struct uart_framing_decoder dec;
+    uart_framing_decoder_init(&dec, UART_FRAMING_CODEC_COBS);
+
+    size_t wire_idx = 0;
+    decode_frame(&dec, wire, wire_len, &wire_idx, decoded);
+
+    zassert_equal(dec.state, FRAMING_STATE_ERR);
+    zassert_equal(wire_idx, aborted_len);
+
+    uart_framing_decoder_resync(&dec);
+    const size_t decoded_len = decode_frame(&dec, wire, wire_len, &wire_idx, decoded);
+
+    zassert_equal(dec.state, FRAMING_STATE_EOF);
+    zassert_equal(decoded_len, sizeof(payload));
+    zassert_mem_equal(decoded, payload, sizeof(payload));
+}
+
+#endif // IS_ENABLED(CONFIG_ZMK_BRIDGE_FRAMING_COBS)
+
+#if UART_FRAMING_CHECK_LEN > 0
+
+ZTEST(uart_framing, test_check_value) {
+    const uint8_t check_input[] = "123456789";
+#if IS_ENABLED(CONFIG_ZMK_BRIDGE_FRAME_CHECK_CRC32)
+    const uint8_t expected[] = {0x26, 0x39, 0xF4, 0xCB};
+#else
+    const uint8_t expected[] = {0xB1, 0x29};
+#endif // IS_ENABLED(CONFIG_ZMK_BRIDGE_FRAME_CHECK_CRC32)
+    uint8_t trailer[UART_FRAMING_CHECK_LEN];
+
+    BUILD_ASSERT(sizeof(expected) == UART_FRAMING_CHECK_LEN);
+
+    // Fed in two pieces, as frames are checked while they are assembled.
+    uint32_t check = uart_framing_check_init();
+    check = uart_framing_check_update(check, check_input, 4);
+    check = uart_framing_check_update(check, &check_input[4], sizeof(check_input) - 1 - 4);
+    uart_framing_check_put(check, trailer);
+
+    zassert_mem_equal(trailer, expected, sizeof(expected));
+}
+
+ZTEST(uart_framing, test_check_trailer_round_trip) {
+    static uint8_t frame[PAYLOAD_MAX + UART_FRAMING_CHECK_LEN];
+    static uint8_t wire[WIRE_MAX + SPLIT_MAX];
+    static uint8_t decoded[PAYLOAD_MAX + UART_FRAMING_CHECK_LEN + SPLIT_MAX];
+    const enum uart_framing_codec codecs[] = {
+        UART_FRAMING_CODEC_ESCAPE,
+#if IS_ENABLED(CONFIG_ZMK_BRIDGE_FRAMING_COBS)
+        UART_FRAMING_CODEC_COBS,
+#endif // IS_ENABLED(CONFIG_ZMK_BRIDGE_FRAMING_COBS)
+    };
+
+    for (int round = 0; round < ROUNDS; round++) {
+        const enum uart_framing_codec codec = codecs[round % ARRAY_SIZE(codecs)];
+        const size_t len = test_rand() % (PAYLOAD_MAX + 1);
+        const size_t frame_len = len + UART_FRAMING_CHECK_LEN;
+
+        fill_payload(frame, len);
+        uart_framing_check_put(uart_framing_check_update(uart_framing_check_init(), frame, len),
+                               &frame[len]);
+
+        const size_t wire_len = encode_frame(codec, frame, frame_len, wire);
+
+        struct uart_framing_decoder dec;
+        uart_framing_decoder_init(&dec, codec);
+
+        size_t wire_idx = 0;
+        const size_t decoded_len = decode_frame(&dec, wire, wire_len, &wire_idx, decoded);
+
+        zassert_equal(dec.state, FRAMING_STATE_EOF);
+        zassert_equal(decoded_len, frame_len);
+        zassert_true(uart_framing_check_frame(decoded, decoded_len), "Round %d failed the check",
+                     round);
+
+        // Any single flipped bit, in the data or the trailer, fails the check.
+        const size_t bit = test_rand() % (frame_len * 8);
+        decoded[bit / 8] ^= BIT(bit % 8);
+        zassert_false(uart_framing_check_frame(decoded, decoded_len),
+                      "Round %d passed the check with bit %zu flipped", round, bit);
+    }
+}
+
+ZTEST(uart_framing, test_check_short_frame) {
+    const uint8_t frame[UART_FRAMING_CHECK_LEN] = {0};
+
+    zassert_false(uart_framing_check_frame(frame, UART_FRAMING_CHECK_LEN - 1));
+}
+
+#endif // UART_FRAMING_CHECK_LEN > 0